@@ -0,0 +1,178 @@
+/*
+ * ConfigGenerator.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: lziegler
+ */
+
+#include "ConfigGenerator.h"
+
+#include <boost/random/uniform_real_distribution.hpp>
+#include <Eigen/Geometry>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+using namespace std;
+
+namespace rct {
+
+ConfigGenerator::ConfigGenerator(unsigned int seed) :
+		rng(seed), quaternionRatio(0.5), fanOut(3) {
+}
+
+ConfigGenerator::~ConfigGenerator() {
+}
+
+void ConfigGenerator::setQuaternionRatio(double ratio) {
+	quaternionRatio = ratio;
+}
+
+void ConfigGenerator::setFanOut(unsigned int fanOut) {
+	this->fanOut = fanOut < 1 ? 1 : fanOut;
+}
+
+string ConfigGenerator::suffix(Format format) {
+	return format == XML ? ".xml" : ".conf";
+}
+
+string ConfigGenerator::frameName(unsigned int index) const {
+	if (index == 0) {
+		return "base";
+	}
+	stringstream ss;
+	ss << "frame_" << index;
+	return ss.str();
+}
+
+string ConfigGenerator::parentName(unsigned int index) const {
+	// transform i connects frame i+1 to its parent, which keeps the frame
+	// names of transforms and messages in a single consistent tree
+	return frameName(index / fanOut);
+}
+
+double ConfigGenerator::uniform(double min, double max) {
+	boost::random::uniform_real_distribution<double> dist(min, max);
+	return dist(rng);
+}
+
+void ConfigGenerator::writeTransforms(ostream& out, Format format, unsigned int count) {
+	out.precision(9);
+	if (format == XML) {
+		out << "<rct>\n";
+		out << "\t<core>\n\t\t<cachetime value=\"30\" />\n\t</core>\n";
+		out << "\t<transforms>\n";
+	} else {
+		out << "[core]\n; cache time in seconds\ncachetime = 30\n";
+	}
+
+	for (unsigned int i = 0; i < count; ++i) {
+		string parent = parentName(i);
+		string child = frameName(i + 1);
+		double x = uniform(-2.0, 2.0);
+		double y = uniform(-2.0, 2.0);
+		double z = uniform(-2.0, 2.0);
+		bool quaternion = uniform(0.0, 1.0) < quaternionRatio;
+
+		if (format == XML) {
+			out << "\t\t<transform parent=\"" << parent << "\" child=\"" << child << "\">\n";
+			out << "\t\t\t<translation x=\"" << x << "\" y=\"" << y << "\" z=\"" << z
+					<< "\" unit=\"METER\" />\n";
+		} else {
+			out << "\n[transform." << i << "]\n";
+			out << "parent = " << parent << "\n";
+			out << "child = " << child << "\n";
+			out << "translation.x = " << x << "\n";
+			out << "translation.y = " << y << "\n";
+			out << "translation.z = " << z << "\n";
+		}
+
+		if (quaternion) {
+			Eigen::Quaterniond q(uniform(-1.0, 1.0), uniform(-1.0, 1.0), uniform(-1.0, 1.0),
+					uniform(-1.0, 1.0));
+			q.normalize();
+			if (format == XML) {
+				out << "\t\t\t<rotation qw=\"" << q.w() << "\" qx=\"" << q.x() << "\" qy=\"" << q.y()
+						<< "\" qz=\"" << q.z() << "\" unit=\"RADIAN\" />\n";
+			} else {
+				out << "rotation.qw = " << q.w() << "\n";
+				out << "rotation.qx = " << q.x() << "\n";
+				out << "rotation.qy = " << q.y() << "\n";
+				out << "rotation.qz = " << q.z() << "\n";
+			}
+		} else {
+			double yaw = uniform(-M_PI, M_PI);
+			double pitch = uniform(-M_PI / 2.0, M_PI / 2.0);
+			double roll = uniform(-M_PI, M_PI);
+			if (format == XML) {
+				out << "\t\t\t<rotation yaw=\"" << yaw << "\" pitch=\"" << pitch << "\" roll=\""
+						<< roll << "\" unit=\"RADIAN\" />\n";
+			} else {
+				out << "rotation.yaw = " << yaw << "\n";
+				out << "rotation.pitch = " << pitch << "\n";
+				out << "rotation.roll = " << roll << "\n";
+			}
+		}
+
+		if (format == XML) {
+			out << "\t\t</transform>\n";
+		}
+	}
+
+	if (format == XML) {
+		out << "\t</transforms>\n";
+		out << "</rct>\n";
+	}
+}
+
+void ConfigGenerator::writeMessages(ostream& out, Format format, unsigned int count) {
+	if (format == XML) {
+		out << "<rct>\n";
+		out << "\t<core>\n\t\t<cachetime value=\"30\" />\n\t</core>\n";
+		out << "\t<messages>\n";
+	} else {
+		out << "[core]\n; cache time in seconds\ncachetime = 30\n";
+	}
+
+	for (unsigned int i = 0; i < count; ++i) {
+		stringstream scope;
+		scope << "/generated/" << frameName(i + 1) << "/pose";
+		stringstream authority;
+		authority << "generator" << (i % 16);
+
+		if (format == XML) {
+			out << "\t\t<message parent=\"" << parentName(i) << "\" child=\"" << frameName(i + 1)
+					<< "\" scope=\"" << scope.str() << "\" authority=\"" << authority.str()
+					<< "\" />\n";
+		} else {
+			out << "\n[message." << i << "]\n";
+			out << "parent = " << parentName(i) << "\n";
+			out << "child = " << frameName(i + 1) << "\n";
+			out << "scope = " << scope.str() << "\n";
+			out << "authority = " << authority.str() << "\n";
+		}
+	}
+
+	if (format == XML) {
+		out << "\t</messages>\n";
+		out << "</rct>\n";
+	}
+}
+
+void ConfigGenerator::writeTransforms(const string& file, Format format, unsigned int count) {
+	ofstream out(file.c_str());
+	if (!out.is_open()) {
+		throw runtime_error("cannot write to " + file);
+	}
+	writeTransforms(out, format, count);
+}
+
+void ConfigGenerator::writeMessages(const string& file, Format format, unsigned int count) {
+	ofstream out(file.c_str());
+	if (!out.is_open()) {
+		throw runtime_error("cannot write to " + file);
+	}
+	writeMessages(out, format, count);
+}
+
+}  // namespace rct
@@ -0,0 +1,56 @@
+/*
+ * ConfigGenerator.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: lziegler
+ */
+
+#pragma once
+
+#include <boost/random/mersenne_twister.hpp>
+#include <ostream>
+#include <string>
+
+namespace rct {
+
+/**
+ * Writes synthetic transform and message configurations in the formats
+ * understood by ParserXML and ParserINI.
+ *
+ * Frames form a tree with a fixed fan-out below a single root. Rotations
+ * alternate randomly between yaw/pitch/roll and quaternion declarations.
+ */
+class ConfigGenerator {
+public:
+	enum Format {
+		XML, INI
+	};
+
+	ConfigGenerator(unsigned int seed = 42);
+	virtual ~ConfigGenerator();
+
+	/**
+	 * Fraction of transforms using a quaternion instead of yaw/pitch/roll.
+	 */
+	void setQuaternionRatio(double ratio);
+	void setFanOut(unsigned int fanOut);
+
+	void writeTransforms(std::ostream& out, Format format, unsigned int count);
+	void writeMessages(std::ostream& out, Format format, unsigned int count);
+
+	void writeTransforms(const std::string& file, Format format, unsigned int count);
+	void writeMessages(const std::string& file, Format format, unsigned int count);
+
+	static std::string suffix(Format format);
+
+private:
+	std::string frameName(unsigned int index) const;
+	std::string parentName(unsigned int index) const;
+	double uniform(double min, double max);
+
+	boost::random::mt19937 rng;
+	double quaternionRatio;
+	unsigned int fanOut;
+};
+
+}  // namespace rct
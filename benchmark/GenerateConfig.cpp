@@ -0,0 +1,81 @@
+/*
+ * GenerateConfig.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: lziegler
+ */
+
+#include "ConfigGenerator.h"
+
+#include <boost/program_options.hpp>
+#include <iostream>
+
+using namespace boost::program_options;
+using namespace std;
+using namespace rct;
+
+int main(int argc, char **argv) {
+	options_description desc("Allowed options");
+	variables_map vm;
+
+	desc.add_options()("help,h", "produce help message") // help
+	("entries,n", value<unsigned int>()->default_value(100), "number of entries") // entries
+	("format", value<string>()->default_value("xml"), "xml or ini") // format
+	("type", value<string>()->default_value("transforms"), "transforms or messages") // type
+	("output,o", value<string>(), "output file (default: stdout)") // output
+	("quaternion-ratio", value<double>()->default_value(0.5),
+			"fraction of transforms with quaternion rotation") // ratio
+	("fan-out", value<unsigned int>()->default_value(3), "children per frame") // fan-out
+	("seed", value<unsigned int>()->default_value(42), "random seed");
+
+	store(parse_command_line(argc, argv, desc), vm);
+	notify(vm);
+
+	if (vm.count("help")) {
+		cout << "Usage:\n  " << argv[0] << " [options]\n" << endl;
+		cout << desc << endl;
+		cout << "Writes a synthetic rct config." << endl;
+		return 0;
+	}
+
+	ConfigGenerator::Format format;
+	string formatArg = vm["format"].as<string>();
+	if (formatArg == "xml") {
+		format = ConfigGenerator::XML;
+	} else if (formatArg == "ini") {
+		format = ConfigGenerator::INI;
+	} else {
+		cerr << "ERROR: unknown format " << formatArg << endl;
+		return 1;
+	}
+
+	string type = vm["type"].as<string>();
+	if (type != "transforms" && type != "messages") {
+		cerr << "ERROR: unknown type " << type << endl;
+		return 1;
+	}
+
+	try {
+		ConfigGenerator generator(vm["seed"].as<unsigned int>());
+		generator.setQuaternionRatio(vm["quaternion-ratio"].as<double>());
+		generator.setFanOut(vm["fan-out"].as<unsigned int>());
+		unsigned int entries = vm["entries"].as<unsigned int>();
+
+		if (vm.count("output")) {
+			string file = vm["output"].as<string>();
+			if (type == "transforms") {
+				generator.writeTransforms(file, format, entries);
+			} else {
+				generator.writeMessages(file, format, entries);
+			}
+		} else if (type == "transforms") {
+			generator.writeTransforms(cout, format, entries);
+		} else {
+			generator.writeMessages(cout, format, entries);
+		}
+	} catch (std::exception &e) {
+		cerr << "Error:\n  " << e.what() << "\n" << endl;
+		return 1;
+	}
+	return 0;
+}
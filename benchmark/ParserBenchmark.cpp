@@ -0,0 +1,241 @@
+/*
+ * ParserBenchmark.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: lziegler
+ */
+
+#include "ConfigGenerator.h"
+#include "parsers/ParserINI.h"
+#include "parsers/ParserXML.h"
+#include "util/AllocationCounter.h"
+#include "util/Clock.h"
+
+#include <boost/algorithm/string.hpp>
+#include <boost/filesystem.hpp>
+#include <boost/lexical_cast.hpp>
+#include <boost/program_options.hpp>
+#include <rsc/logging/Logger.h>
+
+#include <iomanip>
+#include <iostream>
+#include <sys/resource.h>
+#include <unistd.h>
+
+using namespace boost::program_options;
+using namespace std;
+using namespace rsc::logging;
+using namespace rct;
+
+class Measurement {
+public:
+	Measurement() :
+			minNanos(0), totalNanos(0), runs(0), items(0) {
+	}
+	boost::uint64_t minNanos;
+	boost::uint64_t totalNanos;
+	unsigned int runs;
+	size_t items;
+	AllocationStats allocations;
+};
+
+enum Operation {
+	CAN_PARSE, PARSE_TRANSFORMS, PARSE_MESSAGES
+};
+
+const char* operationName(Operation op) {
+	switch (op) {
+	case CAN_PARSE:
+		return "canParse";
+	case PARSE_TRANSFORMS:
+		return "parseStaticTransforms";
+	default:
+		return "parseConvertMessages";
+	}
+}
+
+size_t runOnce(Parser::Ptr parser, Operation op, const string& transformsFile,
+		const string& messagesFile) {
+	switch (op) {
+	case CAN_PARSE:
+		return parser->canParse(transformsFile) ? 1 : 0;
+	case PARSE_TRANSFORMS:
+		return parser->parseStaticTransforms(transformsFile).transforms.size();
+	default:
+		return parser->parseConvertMessages(messagesFile).size();
+	}
+}
+
+Measurement measure(Parser::Ptr parser, Operation op, const string& transformsFile,
+		const string& messagesFile, unsigned int repetitions) {
+	Measurement m;
+	for (unsigned int i = 0; i < repetitions; ++i) {
+		AllocationCounter::resetPeak();
+		AllocationStats before = AllocationCounter::snapshot();
+		boost::uint64_t start = monotonicNanos();
+		m.items = runOnce(parser, op, transformsFile, messagesFile);
+		boost::uint64_t duration = monotonicNanos() - start;
+		AllocationStats after = AllocationCounter::snapshot();
+
+		// allocation numbers are deterministic, keep the ones of the last run
+		m.allocations = AllocationCounter::difference(before, after);
+		m.totalNanos += duration;
+		if (m.runs == 0 || duration < m.minNanos) {
+			m.minNanos = duration;
+		}
+		m.runs++;
+	}
+	return m;
+}
+
+void printHeader() {
+	cout << left << setw(6) << "format" << right << setw(9) << "entries" << "  " << left << setw(22)
+			<< "operation" << right << setw(12) << "min [ms]" << setw(12) << "mean [ms]" << setw(12)
+			<< "us/entry" << setw(12) << "allocs/ent" << setw(12) << "bytes/ent" << setw(12)
+			<< "peak [KiB]" << endl;
+}
+
+void printRow(const string& format, unsigned int entries, Operation op, const Measurement& m) {
+	double perEntry = entries > 0 ? entries : 1;
+	cout << left << setw(6) << format << right << setw(9) << entries << "  " << left << setw(22)
+			<< operationName(op) << right << fixed << setprecision(3) << setw(12)
+			<< nanosToMillis(m.minNanos) << setw(12) << nanosToMillis(m.totalNanos) / m.runs
+			<< setw(12) << m.minNanos / 1000.0 / perEntry << setprecision(1) << setw(12)
+			<< m.allocations.allocations / perEntry << setw(12)
+			<< m.allocations.bytesAllocated / perEntry << setw(12)
+			<< m.allocations.peakBytes / 1024.0 << endl;
+}
+
+vector<unsigned int> parseSizes(const string& sizes) {
+	vector<string> tokens;
+	boost::algorithm::split(tokens, sizes, boost::algorithm::is_any_of(", "),
+			boost::algorithm::token_compress_on);
+	vector<unsigned int> result;
+	for (vector<string>::iterator it = tokens.begin(); it != tokens.end(); ++it) {
+		if (!it->empty()) {
+			result.push_back(boost::lexical_cast<unsigned int>(*it));
+		}
+	}
+	return result;
+}
+
+int main(int argc, char **argv) {
+	options_description desc("Allowed options");
+	variables_map vm;
+
+	desc.add_options()("help,h", "produce help message") // help
+	("sizes", value<string>()->default_value("10,100,1000,10000,100000"),
+			"comma separated numbers of entries") // sizes
+	("format", value<string>()->default_value("all"), "xml, ini or all") // format
+	("repetitions,r", value<unsigned int>()->default_value(3), "runs per measurement") // repetitions
+	("quaternion-ratio", value<double>()->default_value(0.5),
+			"fraction of transforms with quaternion rotation") // ratio
+	("fan-out", value<unsigned int>()->default_value(3), "children per frame") // fan-out
+	("seed", value<unsigned int>()->default_value(42), "random seed") // seed
+	("dir", value<string>(), "directory for the generated configs") // dir
+	("keep", "keep the generated configs") // keep
+	("debug", "debug mode") //debug
+	("trace", "trace mode") //trace
+	("info", "info mode");
+
+	store(parse_command_line(argc, argv, desc), vm);
+	notify(vm);
+
+	if (vm.count("help")) {
+		cout << "Usage:\n  " << argv[0] << " [options]\n" << endl;
+		cout << desc << endl;
+		cout << "Benchmarks the config parsers on generated configs." << endl;
+		return 0;
+	}
+
+	Logger::getLogger("")->setLevel(Logger::LEVEL_WARN);
+	if (vm.count("debug")) {
+		Logger::getLogger("rct")->setLevel(Logger::LEVEL_DEBUG);
+	} else if (vm.count("trace")) {
+		Logger::getLogger("rct")->setLevel(Logger::LEVEL_TRACE);
+	} else if (vm.count("info")) {
+		Logger::getLogger("rct")->setLevel(Logger::LEVEL_INFO);
+	}
+
+	string dir;
+	if (vm.count("dir")) {
+		dir = vm["dir"].as<string>();
+	} else {
+		stringstream tmpss;
+		tmpss << "/tmp/rct" << getuid() << "/parser-benchmark";
+		dir = tmpss.str();
+	}
+
+	string formatArg = vm["format"].as<string>();
+	vector<ConfigGenerator::Format> formats;
+	if (formatArg == "xml" || formatArg == "all") {
+		formats.push_back(ConfigGenerator::XML);
+	}
+	if (formatArg == "ini" || formatArg == "all") {
+		formats.push_back(ConfigGenerator::INI);
+	}
+	if (formats.empty()) {
+		cerr << "ERROR: unknown format " << formatArg << endl;
+		return 1;
+	}
+
+	try {
+		vector<unsigned int> sizes = parseSizes(vm["sizes"].as<string>());
+		unsigned int repetitions = max(1u, vm["repetitions"].as<unsigned int>());
+
+		boost::filesystem::create_directories(dir);
+
+		ConfigGenerator generator(vm["seed"].as<unsigned int>());
+		generator.setQuaternionRatio(vm["quaternion-ratio"].as<double>());
+		generator.setFanOut(vm["fan-out"].as<unsigned int>());
+
+		printHeader();
+		vector<ConfigGenerator::Format>::iterator fIt;
+		for (fIt = formats.begin(); fIt != formats.end(); ++fIt) {
+			ConfigGenerator::Format format = *fIt;
+			string formatName = format == ConfigGenerator::XML ? "xml" : "ini";
+			Parser::Ptr parser;
+			if (format == ConfigGenerator::XML) {
+				parser = ParserXML::Ptr(new ParserXML());
+			} else {
+				parser = ParserINI::Ptr(new ParserINI());
+			}
+
+			vector<unsigned int>::iterator sIt;
+			for (sIt = sizes.begin(); sIt != sizes.end(); ++sIt) {
+				unsigned int entries = *sIt;
+				string base = dir + "/" + boost::lexical_cast<string>(entries);
+				string transformsFile = base + "-transforms" + ConfigGenerator::suffix(format);
+				string messagesFile = base + "-messages" + ConfigGenerator::suffix(format);
+				generator.writeTransforms(transformsFile, format, entries);
+				generator.writeMessages(messagesFile, format, entries);
+
+				Operation ops[] = { CAN_PARSE, PARSE_TRANSFORMS, PARSE_MESSAGES };
+				for (unsigned int i = 0; i < 3; ++i) {
+					Measurement m = measure(parser, ops[i], transformsFile, messagesFile,
+							repetitions);
+					if (ops[i] != CAN_PARSE && m.items != entries) {
+						cerr << "ERROR: " << operationName(ops[i]) << " returned " << m.items
+								<< " of " << entries << " entries" << endl;
+						return 1;
+					}
+					printRow(formatName, entries, ops[i], m);
+				}
+
+				if (!vm.count("keep")) {
+					boost::filesystem::remove(transformsFile);
+					boost::filesystem::remove(messagesFile);
+				}
+			}
+		}
+
+		struct rusage usage;
+		getrusage(RUSAGE_SELF, &usage);
+		cout << "\nmax resident set size: " << usage.ru_maxrss << " KiB" << endl;
+
+	} catch (std::exception &e) {
+		cerr << "Error:\n  " << e.what() << "\n" << endl;
+		return 1;
+	}
+	return 0;
+}
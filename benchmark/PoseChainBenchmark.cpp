@@ -0,0 +1,305 @@
+/*
+ * PoseChainBenchmark.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: lziegler
+ */
+
+#include "convert/PoseConverter.h"
+#include "util/Clock.h"
+#include "util/LatencyStats.h"
+#include "util/RsbTransport.h"
+
+#include <rct/rct.h>
+#include <rct/impl/TransformCommRsb.h>
+
+#define BOOST_SIGNALS_NO_DEPRECATION_WARNING
+#include <rsb/Event.h>
+#include <rsb/Factory.h>
+#include <rsb/Informer.h>
+#include <rsb/MetaData.h>
+
+#include <rst/geometry/Pose.pb.h>
+
+#include <boost/algorithm/string.hpp>
+#include <boost/lexical_cast.hpp>
+#include <boost/program_options.hpp>
+#include <boost/thread/mutex.hpp>
+#include <rsc/logging/Logger.h>
+
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+#include <time.h>
+
+using namespace boost::program_options;
+using namespace std;
+using namespace rsc::logging;
+using namespace rsb;
+using namespace rst::geometry;
+using namespace rct;
+
+const string AUTHORITY = "pose-chain-benchmark";
+
+boost::uint64_t wallMicros() {
+	static const boost::posix_time::ptime epoch(boost::gregorian::date(1970, 1, 1));
+	return (boost::posix_time::microsec_clock::universal_time() - epoch).total_microseconds();
+}
+
+void sleepUntil(boost::uint64_t nanos) {
+	struct timespec ts;
+	ts.tv_sec = nanos / 1000000000ull;
+	ts.tv_nsec = nanos % 1000000000ull;
+	while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL) != 0) {
+	}
+}
+
+/**
+ * Records the delay between the create time of a pose, which becomes the
+ * transform stamp, and the arrival of the transform at the receiver. Poses
+ * created before the last reset() belong to an earlier run and are ignored.
+ */
+class LatencyListener: public TransformListener {
+public:
+	typedef boost::shared_ptr<LatencyListener> Ptr;
+
+	void newTransformAvailable(const Transform& transform, bool isStatic) {
+		if (isStatic || transform.getAuthority() != AUTHORITY) {
+			return;
+		}
+		boost::posix_time::ptime now = boost::posix_time::microsec_clock::universal_time();
+		boost::int64_t micros = (now - transform.getTime()).total_microseconds();
+		boost::mutex::scoped_lock lock(mutex);
+		if (transform.getTime() < runStart) {
+			return;
+		}
+		latencies.add(micros > 0 ? boost::uint64_t(micros) * 1000 : 0);
+	}
+
+	void reset(const boost::posix_time::ptime& start) {
+		boost::mutex::scoped_lock lock(mutex);
+		latencies.clear();
+		runStart = start;
+	}
+
+	size_t received() {
+		boost::mutex::scoped_lock lock(mutex);
+		return latencies.count();
+	}
+
+	LatencyStats stats() {
+		boost::mutex::scoped_lock lock(mutex);
+		return latencies;
+	}
+
+private:
+	boost::mutex mutex;
+	LatencyStats latencies;
+	boost::posix_time::ptime runStart;
+};
+
+class Run {
+public:
+	Run() :
+			mappings(0), rate(0.0), sent(0), received(0), achievedRate(0.0) {
+	}
+	unsigned int mappings;
+	double rate;
+	unsigned long sent;
+	unsigned long received;
+	double achievedRate;
+	LatencyStats latencies;
+
+	double loss() const {
+		return sent > 0 ? 1.0 - double(received) / sent : 0.0;
+	}
+};
+
+vector<double> parseList(const string& list) {
+	vector<string> tokens;
+	boost::algorithm::split(tokens, list, boost::algorithm::is_any_of(", "),
+			boost::algorithm::token_compress_on);
+	vector<double> result;
+	for (vector<string>::iterator it = tokens.begin(); it != tokens.end(); ++it) {
+		if (!it->empty()) {
+			result.push_back(boost::lexical_cast<double>(*it));
+		}
+	}
+	return result;
+}
+
+Run runOnce(vector<Informer<Pose>::Ptr>& informers, LatencyListener::Ptr listener, double rate,
+		double duration, double drain) {
+	Run run;
+	run.mappings = informers.size();
+	run.rate = rate;
+	// poses of the previous run may still be in flight
+	listener->reset(boost::posix_time::microsec_clock::universal_time());
+
+	Informer<Pose>::DataPtr pose(new Pose());
+	pose->mutable_translation()->set_x(1.0);
+	pose->mutable_translation()->set_y(0.0);
+	pose->mutable_translation()->set_z(0.0);
+	pose->mutable_rotation()->set_qw(1.0);
+	pose->mutable_rotation()->set_qx(0.0);
+	pose->mutable_rotation()->set_qy(0.0);
+	pose->mutable_rotation()->set_qz(0.0);
+
+	double tickNanos = 1000000000.0 / rate;
+	boost::uint64_t start = monotonicNanos();
+	boost::uint64_t end = start + boost::uint64_t(duration * 1000000000.0);
+	for (unsigned long tick = 0;; ++tick) {
+		boost::uint64_t deadline = start + boost::uint64_t(tick * tickNanos);
+		if (deadline >= end) {
+			break;
+		}
+		sleepUntil(deadline);
+		Informer<Pose>::Ptr informer = informers[tick % informers.size()];
+		EventPtr event(new Event(informer->getScope(), pose, informer->getType()));
+		event->mutableMetaData().setCreateTime(wallMicros());
+		informer->publish(event);
+		run.sent++;
+	}
+	run.achievedRate = run.sent / ((monotonicNanos() - start) / 1000000000.0);
+
+	// wait for the tail of the queue
+	boost::uint64_t drainEnd = monotonicNanos() + boost::uint64_t(drain * 1000000000.0);
+	while (listener->received() < run.sent && monotonicNanos() < drainEnd) {
+		usleep(1000);
+	}
+	run.latencies = listener->stats();
+	run.received = run.latencies.count();
+	if (run.received > run.sent) {
+		throw runtime_error(
+				"received " + boost::lexical_cast<string>(run.received) + " transforms for "
+						+ boost::lexical_cast<string>(run.sent) + " poses");
+	}
+	return run;
+}
+
+void printHeader() {
+	cout << setw(9) << "mappings" << setw(10) << "rate" << setw(10) << "sent" << setw(10)
+			<< "received" << setw(8) << "loss%" << setw(10) << "p50 ms" << setw(10) << "p90 ms"
+			<< setw(10) << "p99 ms" << setw(10) << "max ms" << endl;
+}
+
+void printRun(Run& run) {
+	cout << setw(9) << run.mappings << setw(10) << fixed << setprecision(0) << run.achievedRate
+			<< setw(10) << run.sent << setw(10) << run.received << setw(8) << setprecision(2)
+			<< 100.0 * run.loss() << setprecision(3) << setw(10)
+			<< nanosToMillis(run.latencies.percentile(0.5)) << setw(10)
+			<< nanosToMillis(run.latencies.percentile(0.9)) << setw(10)
+			<< nanosToMillis(run.latencies.percentile(0.99)) << setw(10)
+			<< nanosToMillis(run.latencies.max()) << endl;
+}
+
+int main(int argc, char **argv) {
+	options_description desc("Allowed options");
+	variables_map vm;
+
+	desc.add_options()("help,h", "produce help message") // help
+	("mappings", value<string>()->default_value("1,10,100,1000"),
+			"comma separated numbers of configured scopes") // mappings
+	("rates", value<string>()->default_value("100,1000,5000,10000,20000,50000"),
+			"comma separated total pose rates (1/s)") // rates
+	("duration", value<double>()->default_value(2.0), "publishing time per run (seconds)") // duration
+	("drain", value<double>()->default_value(1.0),
+			"time to wait for outstanding transforms after a run (seconds)") // drain
+	("max-loss", value<double>()->default_value(0.001),
+			"largest fraction of lost transforms for a sustainable rate") // loss
+	("max-p99", value<double>()->default_value(10.0),
+			"largest 99th percentile latency for a sustainable rate (milliseconds)") // p99
+	("debug", "debug mode") //debug
+	("trace", "trace mode") //trace
+	("info", "info mode");
+
+	store(parse_command_line(argc, argv, desc), vm);
+	notify(vm);
+
+	if (vm.count("help")) {
+		cout << "Usage:\n  " << argv[0] << " [options]\n" << endl;
+		cout << desc << endl;
+		cout << "Publishes poses, converts them like rct-from-rst and receives the transforms,"
+				<< endl << "all in this process on the in-process transport." << endl;
+		return 0;
+	}
+
+	Logger::getLogger("")->setLevel(Logger::LEVEL_WARN);
+	if (vm.count("debug")) {
+		Logger::getLogger("rct")->setLevel(Logger::LEVEL_DEBUG);
+	} else if (vm.count("trace")) {
+		Logger::getLogger("rct")->setLevel(Logger::LEVEL_TRACE);
+	} else if (vm.count("info")) {
+		Logger::getLogger("rct")->setLevel(Logger::LEVEL_INFO);
+	}
+
+	// before the first use of the factory, so rct's participants use it too
+	useInprocessTransportOnly();
+
+	try {
+		vector<double> mappings = parseList(vm["mappings"].as<string>());
+		vector<double> rates = parseList(vm["rates"].as<string>());
+		double duration = vm["duration"].as<double>();
+		double drain = vm["drain"].as<double>();
+		double maxLoss = vm["max-loss"].as<double>();
+		double maxP99 = vm["max-p99"].as<double>();
+
+		PoseConverter::registerConverters();
+		LatencyListener::Ptr listener(new LatencyListener());
+		TransformReceiver::Ptr receiver = getTransformerFactory().createTransformReceiver(
+				listener);
+		TransformCommRsb::Ptr comm(new TransformCommRsb(AUTHORITY, vector<TransformListener::Ptr>()));
+		comm->init(TransformerConfig());
+
+		printHeader();
+		vector<pair<unsigned int, double> > sustainable;
+		for (vector<double>::iterator mIt = mappings.begin(); mIt != mappings.end(); ++mIt) {
+			unsigned int count = (unsigned int) *mIt;
+			if (count == 0) {
+				continue;
+			}
+
+			vector<ParserResultMessage> messages;
+			vector<Informer<Pose>::Ptr> informers;
+			for (unsigned int i = 0; i < count; ++i) {
+				ParserResultMessage message;
+				message.parent = "world";
+				message.child = "bench" + boost::lexical_cast<string>(i);
+				message.scope = "/rct/benchmark/pose/" + boost::lexical_cast<string>(i);
+				message.authority = AUTHORITY;
+				messages.push_back(message);
+				informers.push_back(
+						getFactory().createInformer<Pose>(message.scope,
+								inprocessParticipantConfig()));
+			}
+
+			PoseConverter converter(comm);
+			converter.addMessages(messages);
+			converter.start(inprocessParticipantConfig());
+
+			double best = 0.0;
+			for (vector<double>::iterator rIt = rates.begin(); rIt != rates.end(); ++rIt) {
+				Run run = runOnce(informers, listener, *rIt, duration, drain);
+				printRun(run);
+				if (run.loss() <= maxLoss && nanosToMillis(run.latencies.percentile(0.99)) <= maxP99) {
+					best = max(best, run.achievedRate);
+				}
+			}
+			sustainable.push_back(make_pair(count, best));
+		}
+
+		cout << endl << "max sustainable rate (loss <= " << 100.0 * maxLoss << "%, p99 <= "
+				<< maxP99 << " ms)" << endl;
+		vector<pair<unsigned int, double> >::iterator sIt;
+		for (sIt = sustainable.begin(); sIt != sustainable.end(); ++sIt) {
+			cout << setw(9) << sIt->first << setw(10) << fixed << setprecision(0) << sIt->second << " /s"
+					<< endl;
+		}
+
+	} catch (std::exception &e) {
+		cerr << "Error:\n  " << e.what() << "\n" << endl;
+		return 1;
+	}
+
+	return 0;
+}
@@ -7,8 +7,10 @@
 
 
 #include <stdlib.h>
+#include <time.h>
 
 #define BOOST_SIGNALS_NO_DEPRECATION_WARNING
+#include <rsb/Event.h>
 #include <rsb/Informer.h>
 #include <rsb/Factory.h>
 #include <rsb/converter/ProtocolBufferConverter.h>
@@ -16,38 +18,250 @@
 
 #include <rst/geometry/Pose.pb.h>
 
+#include "parsers/WriterXML.h"
+#include "util/Clock.h"
+
+#include <boost/date_time/posix_time/posix_time.hpp>
+#include <boost/program_options.hpp>
+#include <cmath>
+#include <csignal>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+
 using namespace std;
+using namespace boost::program_options;
 using namespace rsb;
 using namespace rsb::converter;
 using namespace rst::geometry;
+using rct::monotonicNanos;
+
+volatile sig_atomic_t running = 1;
+
+void handleSignal(int) {
+	running = 0;
+}
+
+enum Trajectory {
+	STATIONARY, CIRCLE, LINE
+};
+
+class LoadOptions {
+public:
+	string scope;
+	unsigned int scopes;
+	double rate;
+	unsigned int burst;
+	Trajectory trajectory;
+	double radius;
+	double speed;
+	double duration;
+	string config;
+	string parent;
+	string authority;
+};
+
+void sleepUntil(boost::uint64_t nanos) {
+	struct timespec ts;
+	ts.tv_sec = nanos / 1000000000ull;
+	ts.tv_nsec = nanos % 1000000000ull;
+	while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL) != 0 && running) {
+	}
+}
+
+boost::uint64_t wallMicros() {
+	static const boost::posix_time::ptime epoch(boost::gregorian::date(1970, 1, 1));
+	return (boost::posix_time::microsec_clock::universal_time() - epoch).total_microseconds();
+}
+
+string scopeName(const LoadOptions &options, unsigned int index) {
+	if (options.scopes == 1) {
+		return options.scope;
+	}
+	stringstream ss;
+	ss << options.scope << "/" << index;
+	return ss.str();
+}
+
+string childName(unsigned int index) {
+	stringstream ss;
+	ss << "load" << index;
+	return ss.str();
+}
+
+void fillPose(Pose &pose, const LoadOptions &options, unsigned int index, double t) {
+	double x = 2.0;
+	double y = 1.0 + index;
+	double yaw = 0.0;
+	switch (options.trajectory) {
+	case STATIONARY:
+		break;
+	case CIRCLE: {
+		double angle = options.speed * t / options.radius;
+		x = options.radius * cos(angle);
+		y = options.radius * sin(angle) + index;
+		yaw = angle + M_PI / 2.0;
+		break;
+	}
+	case LINE: {
+		// back and forth between -radius and radius
+		double period = 4.0 * options.radius / options.speed;
+		double phase = fmod(t, period) / period;
+		x = options.radius * (phase < 0.5 ? 4.0 * phase - 1.0 : 3.0 - 4.0 * phase);
+		yaw = phase < 0.5 ? 0.0 : M_PI;
+		break;
+	}
+	}
 
-int main(void) {
+	pose.mutable_translation()->set_x(x);
+	pose.mutable_translation()->set_y(y);
+	pose.mutable_translation()->set_z(0.0);
+
+	pose.mutable_rotation()->set_qw(cos(yaw / 2.0));
+	pose.mutable_rotation()->set_qx(0.0);
+	pose.mutable_rotation()->set_qy(0.0);
+	pose.mutable_rotation()->set_qz(sin(yaw / 2.0));
+}
+
+void writeConfig(const LoadOptions &options) {
+	vector<rct::ParserResultMessage> messages;
+	for (unsigned int i = 0; i < options.scopes; ++i) {
+		rct::ParserResultMessage message;
+		message.parent = options.parent;
+		message.child = childName(i);
+		message.scope = scopeName(options, i);
+		message.authority = options.authority;
+		messages.push_back(message);
+	}
+	rct::WriterXML writer;
+	writer.writeConvertMessages(options.config, messages);
+	cerr << "wrote rct-from-rst config " << options.config << endl;
+}
+
+bool handleArgs(int argc, char **argv, LoadOptions &options) {
+	options_description desc("Allowed options");
+	variables_map vm;
+
+	string trajectory;
+	desc.add_options()("help,h", "produce help message") // help
+	("scope,s", value<string>(&options.scope)->default_value("/nav/slampose"),
+			"scope, or scope prefix if several scopes are used") // scope
+	("scopes,n", value<unsigned int>(&options.scopes)->default_value(1), "number of scopes") // scopes
+	("rate,r", value<double>(&options.rate)->default_value(10.0), "poses per second and scope") // rate
+	("burst,b", value<unsigned int>(&options.burst)->default_value(1),
+			"poses sent back to back per scope, bursts are spaced to keep the rate") // burst
+	("trajectory,t", value<string>(&trajectory)->default_value("stationary"),
+			"stationary, circle or line") // trajectory
+	("radius", value<double>(&options.radius)->default_value(1.0),
+			"radius of the circle or half length of the line (meters)") // radius
+	("speed", value<double>(&options.speed)->default_value(0.5), "speed along the trajectory (m/s)") // speed
+	("duration,d", value<double>(&options.duration)->default_value(0.0),
+			"stop after this time, 0 runs until interrupted (seconds)") // duration
+	("write-config,c", value<string>(&options.config),
+			"write a matching rct-from-rst XML config to this file") // config
+	("parent", value<string>(&options.parent)->default_value("world"),
+			"parent frame used in the written config") // parent
+	("authority", value<string>(&options.authority)->default_value("pose-publisher"),
+			"authority used in the written config"); // authority
+
+	store(parse_command_line(argc, argv, desc), vm);
+	notify(vm);
+
+	if (vm.count("help")) {
+		cout << "Usage:\n  " << argv[0] << " [options]\n" << endl;
+		cout << desc << endl;
+		return false;
+	}
+
+	if (trajectory == "stationary") {
+		options.trajectory = STATIONARY;
+	} else if (trajectory == "circle") {
+		options.trajectory = CIRCLE;
+	} else if (trajectory == "line") {
+		options.trajectory = LINE;
+	} else {
+		throw invalid_argument("unknown trajectory " + trajectory);
+	}
+	if (options.scopes == 0 || options.burst == 0 || options.rate <= 0.0) {
+		throw invalid_argument("scopes, burst and rate must be positive");
+	}
+	if (options.radius <= 0.0 || options.speed <= 0.0) {
+		throw invalid_argument("radius and speed must be positive");
+	}
+	return true;
+}
+
+int main(int argc, char **argv) {
+
+	LoadOptions options;
+	try {
+		if (!handleArgs(argc, argv, options)) {
+			return EXIT_SUCCESS;
+		}
+	} catch (std::exception &e) {
+		cerr << "Error:\n  " << e.what() << "\n" << endl;
+		return EXIT_FAILURE;
+	}
 
 	Converter<string>::Ptr converter(new ProtocolBufferConverter<Pose>());
 	converterRepository<string>()->registerConverter(converter);
 
+	signal(SIGINT, handleSignal);
+	signal(SIGTERM, handleSignal);
 
-    Factory& factory = getFactory();
+	try {
+		if (!options.config.empty()) {
+			writeConfig(options);
+		}
 
-    Informer<Pose>::Ptr informer = factory.createInformer<Pose> ("/nav/slampose");
+		Factory& factory = getFactory();
 
-    while (true) {
-		Informer<Pose>::DataPtr s(new Pose());
-		s->mutable_translation()->set_x(2.0);
-		s->mutable_translation()->set_y(1.0);
-		s->mutable_translation()->set_z(0.0);
+		vector<Informer<Pose>::Ptr> informers;
+		for (unsigned int i = 0; i < options.scopes; ++i) {
+			informers.push_back(factory.createInformer<Pose>(scopeName(options, i)));
+		}
 
-		s->mutable_rotation()->set_qw(1.0);
-		s->mutable_rotation()->set_qx(0.0);
-		s->mutable_rotation()->set_qy(0.0);
-		s->mutable_rotation()->set_qz(0.0);
+		// bursts of all scopes are interleaved evenly, one tick per burst
+		double tickNanos = 1000000000.0 * options.burst / (options.rate * options.scopes);
+		boost::uint64_t start = monotonicNanos();
+		boost::uint64_t end = start + boost::uint64_t(options.duration * 1000000000.0);
+		boost::uint64_t maxLateness = 0;
+		unsigned long sent = 0;
 
-		// Send the data.
-		informer->publish(s);
+		for (unsigned long tick = 0; running; ++tick) {
+			boost::uint64_t deadline = start + boost::uint64_t(tick * tickNanos);
+			if (options.duration > 0.0 && deadline >= end) {
+				break;
+			}
+			sleepUntil(deadline);
+			boost::uint64_t now = monotonicNanos();
+			if (now > deadline) {
+				maxLateness = max(maxLateness, now - deadline);
+			}
 
-		usleep(100*1000);
-    }
+			unsigned int index = tick % options.scopes;
+			for (unsigned int i = 0; i < options.burst; ++i) {
+				Informer<Pose>::DataPtr pose(new Pose());
+				fillPose(*pose, options, index, (now - start) / 1000000000.0);
 
-    return EXIT_SUCCESS;
-}
+				// stamp right before publishing, rct-from-rst uses the create time
+				EventPtr event(new Event(informers[index]->getScope(), pose,
+						informers[index]->getType()));
+				event->mutableMetaData().setCreateTime(wallMicros());
+				informers[index]->publish(event);
+				sent++;
+			}
+		}
+
+		double elapsed = (monotonicNanos() - start) / 1000000000.0;
+		cerr << "sent " << sent << " poses on " << options.scopes << " scopes in " << elapsed
+				<< " s (" << sent / elapsed << " /s), max schedule lateness "
+				<< maxLateness / 1000000.0 << " ms" << endl;
 
+	} catch (std::exception &e) {
+		cerr << "Error:\n  " << e.what() << "\n" << endl;
+		return EXIT_FAILURE;
+	}
+
+	return EXIT_SUCCESS;
+}
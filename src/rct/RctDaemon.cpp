@@ -0,0 +1,310 @@
+/*
+ * RctDaemon.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: lziegler
+ */
+
+#include "rct-tools-config.h"
+#include "convert/PoseConverter.h"
+#include "daemon/TransformHub.h"
+#include "parsers/ParserINI.h"
+#include "parsers/ParserXML.h"
+#include "shm/TransformSnapshot.h"
+#include "sync/StaticSyncServer.h"
+#include "util/AllocationCounter.h"
+#include "util/Realtime.h"
+#include "util/StartupProfiler.h"
+#ifdef RCT_ROS_BRIDGE
+#include "bridge/RctRosBridge.h"
+#include <rct/impl/TransformCommRos.h>
+#endif
+#include <rct/rct.h>
+#include <rct/impl/TransformCommRsb.h>
+
+#include <boost/lexical_cast.hpp>
+#include <boost/program_options.hpp>
+#include <rsb/Factory.h>
+#include <rsc/logging/Logger.h>
+#include <rsc/logging/LoggerFactory.h>
+#include <iostream>
+#include <csignal>
+#include <unistd.h>
+
+using namespace boost::program_options;
+using namespace std;
+using namespace rsc::logging;
+using namespace rct;
+
+volatile sig_atomic_t running = 1;
+#ifdef RCT_ROS_BRIDGE
+RctRosBridge *bridge = 0;
+#endif
+
+void signalHandler(int signum) {
+	cout << "Interrupt signal (" << signum << ") received." << endl;
+	running = 0;
+#ifdef RCT_ROS_BRIDGE
+	if (bridge) {
+		bridge->interrupt();
+	}
+#endif
+}
+
+Parser::Ptr parserFor(const string &configFile) {
+	std::vector<Parser::Ptr> parsers;
+	parsers.push_back(rct::ParserINI::Ptr(new rct::ParserINI()));
+	parsers.push_back(rct::ParserXML::Ptr(new rct::ParserXML()));
+
+	vector<Parser::Ptr>::iterator it;
+	for (it = parsers.begin(); it != parsers.end(); ++it) {
+		if ((*it)->canParse(configFile)) {
+			return *it;
+		}
+	}
+	throw invalid_argument("cannot parse config file " + configFile);
+}
+
+/**
+ * The bridge does not forward transforms of its own rsb authority, so the
+ * authority of a daemon must not be shared with another daemon started
+ * under the same name.
+ */
+string processAuthority(const string& name) {
+	char host[256];
+	if (gethostname(host, sizeof(host)) != 0) {
+		host[0] = 0;
+	}
+	host[sizeof(host) - 1] = 0;
+	return name + "@" + host + ":" + boost::lexical_cast<string>(getpid());
+}
+
+int main(int argc, char **argv) {
+	StartupProfiler profiler;
+	options_description desc("Allowed options");
+	variables_map vm;
+
+	desc.add_options()("help,h", "produce help message") // help
+	("name,n", value<string>()->default_value("rct-daemon"),
+			"name for this instance, host and process id are appended for its authority") // name
+	("static,s", value<vector<string> >()->composing(),
+			"static transforms config, as for rct-static-publisher") // static
+	("rst,r", value<vector<string> >()->composing(),
+			"rst message config, as for rct-from-rst") // rst
+	("sync", "serve the static transforms to late joining receivers") // sync
+	("sync-scope", value<string>()->default_value(StaticSyncServer::DEFAULT_SCOPE),
+			"scope of the static sync service") // sync scope
+	("shm", value<string>()->implicit_value(TransformSnapshotWriter::DEFAULT_NAME),
+			"keep the latest transform of every edge in this shared memory segment") // shm
+	("shm-capacity", value<unsigned int>()->default_value(TransformSnapshotWriter::DEFAULT_CAPACITY),
+			"maximum number of edges in the shared memory segment") // shm capacity
+#ifdef RCT_ROS_BRIDGE
+	("ros-bridge", "bridge transforms between RSB and ROS") // bridge
+	("static-snapshot", value<string>(),
+			"keep the statics bridged by --ros-bridge in this file and republish them on startup") // snapshot
+#endif
+	("stale-factor", value<double>(),
+			"warn about dynamic edges not updated for this many mean publish intervals") // stale factor
+	("stale-timeout", value<double>(), "warn about dynamic edges not updated for this time (seconds)") // stale timeout
+	("startup-profile", "print the time spent in each startup phase once started") // startup profile
+	("debug", "debug mode") //debug
+	("trace", "trace mode") //trace
+	("info", "info mode")("log-prop,l", value<string>(), "logging properties");
+
+	desc.add(RealtimeOptions::description());
+
+	store(parse_command_line(argc, argv, desc), vm);
+	notify(vm);
+
+	if (vm.count("help")) {
+		cout << "Usage:\n  " << argv[0] << " [options]\n" << endl;
+		cout << desc << endl;
+		cout << "Runs the static publisher, the rst converter and the ROS bridge in one process."
+				<< endl;
+		return 0;
+	}
+
+	Logger::getLogger("")->setLevel(Logger::LEVEL_WARN);
+	if (vm.count("debug")) {
+		Logger::getLogger("rct")->setLevel(Logger::LEVEL_DEBUG);
+	} else if (vm.count("trace")) {
+		Logger::getLogger("rct")->setLevel(Logger::LEVEL_TRACE);
+	} else if (vm.count("info")) {
+		Logger::getLogger("rct")->setLevel(Logger::LEVEL_INFO);
+	} else if (vm.count("log-prop")) {
+		string properties = vm["log-prop"].as<string>();
+		cout << "Using logging properties: " << properties << endl;
+		LoggerFactory::getInstance().reconfigureFromFile(properties);
+	}
+
+	LoggerPtr logger = Logger::getLogger("rct.RctDaemon");
+	string name = processAuthority(vm["name"].as<string>());
+	vector<string> staticConfigs;
+	if (vm.count("static")) {
+		staticConfigs = vm["static"].as<vector<string> >();
+	}
+	vector<string> rstConfigs;
+	if (vm.count("rst")) {
+		rstConfigs = vm["rst"].as<vector<string> >();
+	}
+
+	signal(SIGINT, signalHandler);
+	signal(SIGTERM, signalHandler);
+	profiler.mark("options");
+
+	try {
+		// parse everything before going online
+		ParserResultTransforms statics;
+		vector<string>::iterator cIt;
+		for (cIt = staticConfigs.begin(); cIt != staticConfigs.end(); ++cIt) {
+			RSCDEBUG(logger, "reading static config file: " << *cIt);
+			Parser::Ptr parser = parserFor(*cIt);
+			profiler.mark("config canParse " + *cIt);
+			ParserResultTransforms result = parser->parseStaticTransforms(*cIt);
+			profiler.mark("config parse " + *cIt);
+			if (statics.transforms.empty()) {
+				statics.config = result.config;
+			}
+			statics.transforms.insert(statics.transforms.end(), result.transforms.begin(),
+					result.transforms.end());
+		}
+		vector<ParserResultMessage> messages;
+		for (cIt = rstConfigs.begin(); cIt != rstConfigs.end(); ++cIt) {
+			RSCDEBUG(logger, "reading rst config file: " << *cIt);
+			Parser::Ptr parser = parserFor(*cIt);
+			profiler.mark("config canParse " + *cIt);
+			vector<ParserResultMessage> result = parser->parseConvertMessages(*cIt);
+			profiler.mark("config parse " + *cIt);
+			messages.insert(messages.end(), result.begin(), result.end());
+		}
+
+		// before any communicator, so that the middleware threads inherit it
+		RealtimeOptions realtime(vm);
+		realtime.apply();
+		WakeupLatencyMonitor::Ptr wakeup;
+		if (realtime.reportWakeupLatency()) {
+			wakeup = WakeupLatencyMonitor::Ptr(
+					new WakeupLatencyMonitor(cerr, realtime.wakeupReportInterval));
+		}
+		profiler.mark("real-time setup");
+
+		// one rsb communicator for all modules
+		TransformerConfig rsbConfig;
+		rsbConfig.setCommType(TransformerConfig::RSB);
+		TransformCommRsb::Ptr rsb(new TransformCommRsb(name, vector<TransformListener::Ptr>()));
+		rsb->init(rsbConfig);
+		TransformHub::Ptr hub(new TransformHub(rsb));
+		profiler.mark("create communicator");
+
+		StalenessWatchdog::Ptr watchdog;
+		if (vm.count("stale-factor") || vm.count("stale-timeout")) {
+			watchdog = StalenessWatchdog::Ptr(
+					new StalenessWatchdog(vm.count("stale-factor") ? vm["stale-factor"].as<double>() : 0.0,
+							vm.count("stale-timeout") ? vm["stale-timeout"].as<double>() : 0.0));
+		}
+
+		TransformSnapshotWriter::Ptr snapshot;
+		if (vm.count("shm")) {
+			snapshot = TransformSnapshotWriter::Ptr(
+					new TransformSnapshotWriter(vm["shm"].as<string>(),
+							vm["shm-capacity"].as<unsigned int>()));
+			hub->addTransformListener(snapshot);
+			profiler.mark("create snapshot");
+		}
+
+#ifdef RCT_ROS_BRIDGE
+		boost::shared_ptr<ros::AsyncSpinner> spinner;
+		if (vm.count("ros-bridge")) {
+			ros::init(argc, argv, "rctrosbridge", ros::init_options::NoSigintHandler);
+			profiler.mark("ros::init");
+			// the bridge sends ROS transforms through rsb directly, so they are
+			// not handed back to itself by the hub
+			TransformCommunicator::Ptr rsbComm = rsb;
+			bridge = new RctRosBridge(name, rsbComm);
+			hub->addTransformListener(bridge->getRsbListener());
+			if (vm.count("static-snapshot")) {
+				bridge->setStaticStore(
+						StaticTransformStore::Ptr(
+								new StaticTransformStore(vm["static-snapshot"].as<string>())));
+			}
+			if (watchdog) {
+				// the bridge sees the converted poses through the hub as well
+				bridge->setWatchdog(watchdog);
+			}
+			spinner = boost::shared_ptr<ros::AsyncSpinner>(new ros::AsyncSpinner(4));
+			spinner->start();
+			profiler.mark("create bridge");
+		}
+#endif
+
+		StaticSyncServer::Ptr syncServer;
+		if (vm.count("sync")) {
+			syncServer = StaticSyncServer::Ptr(
+					new StaticSyncServer(rsb::Scope(vm["sync-scope"].as<string>()),
+							rsb::getFactory().getDefaultParticipantConfig()));
+			syncServer->setTransforms(statics.transforms);
+			profiler.mark("sync server");
+		}
+
+		if (!statics.transforms.empty()) {
+			vector<Transform>::iterator tIt;
+			for (tIt = statics.transforms.begin(); tIt != statics.transforms.end(); ++tIt) {
+				if (tIt->getAuthority().empty()) {
+					tIt->setAuthority(name + "/static");
+				}
+			}
+			hub->sendTransform(statics.transforms, rct::STATIC);
+			RSCINFO(logger, "published " << statics.transforms.size() << " static transforms");
+			profiler.mark("send static transforms");
+		}
+
+		PoseConverter converter(hub);
+		if (!messages.empty()) {
+			converter.addMessages(messages);
+			bool bridgeWatches = false;
+#ifdef RCT_ROS_BRIDGE
+			bridgeWatches = bridge != 0;
+#endif
+			if (watchdog && !bridgeWatches) {
+				converter.setWatchdog(watchdog);
+			}
+			converter.start();
+			RSCINFO(logger, "converting " << converter.mappingCount() << " rst scopes");
+			profiler.mark("create rst listeners");
+		}
+
+		cout << "successfully started" << endl;
+		if (vm.count("startup-profile")) {
+			profiler.report(cerr);
+		}
+
+		int ret = 0;
+#ifdef RCT_ROS_BRIDGE
+		if (bridge) {
+			// blocks until interrupted or ROS shuts down
+			ret = bridge->run();
+			running = 0;
+		}
+#endif
+		while (running) {
+			sleep(1);
+		}
+		RSCDEBUG(logger, "interrupted");
+
+		converter.stop();
+		hub->shutdown();
+#ifdef RCT_ROS_BRIDGE
+		delete bridge;
+		bridge = 0;
+#endif
+#ifdef RCT_ALLOC_ACCOUNTING
+		AllocationCounter::report(cerr);
+#endif
+		cout << "done" << endl;
+		return ret;
+
+	} catch (std::exception &e) {
+		cerr << "Error:\n  " << e.what() << "\n" << endl;
+		return 1;
+	}
+}
@@ -6,15 +6,100 @@
  */
 #include <rct/rctConfig.h>
 #include <rct/TransformerFactory.h>
+#include "graph/FrameGraph.h"
+#include "shm/TransformSnapshot.h"
+#include "sync/StaticSyncClient.h"
+#include "sync/StaticSyncServer.h"
+#include "util/Clock.h"
+#include "util/Json.h"
+#include "util/LatencyStats.h"
+#include "util/StartupProfiler.h"
 #include <boost/program_options.hpp>
+#include <boost/thread.hpp>
+#include <rsb/Factory.h>
 #include <rsc/logging/Logger.h>
 #include <rsc/logging/OptionBasedConfigurator.h>
+#include <algorithm>
+#include <csignal>
+#include <fstream>
+#include <iomanip>
+#include <stdexcept>
 
 using namespace boost::program_options;
 using namespace std;
 using namespace rct;
 using namespace rsc::logging;
 
+// a time of zero requests the latest available transform
+const boost::posix_time::ptime LATEST = boost::posix_time::from_time_t(0);
+
+bool running = true;
+
+void signalHandler(int signum) {
+	running = false;
+}
+
+class EchoOptions {
+public:
+	EchoOptions() :
+			matrix(false), quaternion(false), rate(0.0), follow(false), timeout(2.0), json(false), benchmark(0), startupProfile(false) {
+	}
+	string frameTarget;
+	string frameSource;
+	bool matrix;
+	bool quaternion;
+	string staticSyncScope;
+	string snapshot;
+	double rate;
+	bool follow;
+	double timeout;
+	string batchFile;
+	bool json;
+	unsigned int benchmark;
+	bool startupProfile;
+};
+
+class BatchQuery {
+public:
+	string frameSource;
+	string frameTarget;
+	boost::posix_time::ptime time;
+	TransformReceiver::FuturePtr future;
+};
+
+/**
+ * Wakes up the follow loop whenever the receiver gets a new transform.
+ */
+class ChangeNotifier: public TransformListener {
+public:
+	typedef boost::shared_ptr<ChangeNotifier> Ptr;
+	ChangeNotifier() :
+			updates(0) {
+	}
+	virtual ~ChangeNotifier() {
+	}
+	void newTransformAvailable(const Transform& transform, bool isStatic) {
+		boost::mutex::scoped_lock lock(mutex);
+		updates++;
+		cond.notify_all();
+	}
+	/**
+	 * Blocks until the number of updates differs from seen or the timeout
+	 * (seconds) expires. Returns the current number of updates.
+	 */
+	unsigned long waitForUpdate(unsigned long seen, double timeout) {
+		boost::mutex::scoped_lock lock(mutex);
+		if (updates == seen) {
+			cond.timed_wait(lock, boost::posix_time::microseconds(long(timeout * 1000000.0)));
+		}
+		return updates;
+	}
+private:
+	boost::mutex mutex;
+	boost::condition_variable cond;
+	unsigned long updates;
+};
+
 void printHelp(int argc, char **argv, options_description desc) {
 	cout << "Usage:\n  " << argv[0] << " [options] source_frame target_frame\n" << endl;
 	cout << desc << endl;
@@ -25,8 +110,7 @@ void printHelp(int argc, char **argv, options_description desc) {
 	cout << "target_frame into the source_frame." << endl;
 }
 
-int handleArgs(int argc, char **argv, string &frame_target, string &frame_source, bool &matrix,
-		bool &quaternion) {
+int handleArgs(int argc, char **argv, EchoOptions &options) {
 	boost::program_options::positional_options_description p0;
 	p0.add("frames", -1);
 
@@ -38,6 +122,18 @@ int handleArgs(int argc, char **argv, string &frame_target, string &frame_source
 	("trace", "trace mode") //trace
 	("matrix", "print transformation matrix") //matrix
 	("quaternion", "print rotation as quaternion") //quaternion
+	("static-sync", value<string>()->implicit_value(StaticSyncServer::DEFAULT_SCOPE),
+			"resolve static transforms through the sync service of rct-static-publisher") //static sync
+	("shm", value<string>()->implicit_value(TransformSnapshotWriter::DEFAULT_NAME),
+			"read the latest transforms from the shared memory segment of rct-daemon") //shm
+	("rate", value<double>(), "keep running and print the latest transform at this rate (Hz)") //rate
+	("follow", "keep running and print the transform whenever it changes") //follow
+	("timeout", value<double>(), "time waiting for the first transform (seconds)") //timeout
+	("batch", value<string>(), "query all frame pairs listed in this file ('-' for stdin)") //batch
+	("format", value<string>()->default_value("csv"), "batch output format: csv or json") //format
+	("benchmark", value<unsigned int>(),
+			"measure cold and warm lookup latency with this many warm queries per pair") //benchmark
+	("startup-profile", "print the time spent in each startup phase once ready") // startup profile
 	("info", "info mode");
 
 	options_description hidden("Hidden options");
@@ -64,6 +160,72 @@ int handleArgs(int argc, char **argv, string &frame_target, string &frame_source
 	}
 
 
+	if (vm.count("benchmark")) {
+		options.benchmark = vm["benchmark"].as<unsigned int>();
+	}
+	options.startupProfile = vm.count("startup-profile");
+	options.matrix = vm.count("matrix");
+	options.quaternion = vm.count("quaternion");
+	if (vm.count("static-sync")) {
+		options.staticSyncScope = vm["static-sync"].as<string>();
+	}
+	if (vm.count("shm")) {
+		options.snapshot = vm["shm"].as<string>();
+		if (vm.count("follow")) {
+			cerr << "ERROR: --follow is not supported with --shm, use --rate" << endl;
+			return -1;
+		}
+	}
+	if (vm.count("rate")) {
+		options.rate = vm["rate"].as<double>();
+		if (options.rate <= 0.0) {
+			cerr << "ERROR: --rate must be positive" << endl;
+			return -1;
+		}
+	}
+	options.follow = vm.count("follow");
+	if (vm.count("timeout")) {
+		options.timeout = vm["timeout"].as<double>();
+	}
+	string format = vm["format"].as<string>();
+	if (format != "csv" && format != "json") {
+		cerr << "ERROR: unknown format " << format << endl;
+		return -1;
+	}
+	options.json = format == "json";
+
+	// options that the batch and benchmark modes would silently ignore
+	if (vm.count("batch")) {
+		options.batchFile = vm["batch"].as<string>();
+		if (vm.count("frames")) {
+			cerr << "ERROR: frames are read from the batch file, not given with --batch" << endl;
+			return -1;
+		}
+		const char* unsupported[] = { "static-sync", "shm", "rate", "follow", "matrix",
+				"quaternion" };
+		for (size_t i = 0; i < sizeof(unsupported) / sizeof(unsupported[0]); ++i) {
+			if (vm.count(unsupported[i])) {
+				cerr << "ERROR: --" << unsupported[i] << " is not supported with --batch" << endl;
+				return -1;
+			}
+		}
+	} else if (!vm["format"].defaulted()) {
+		cerr << "ERROR: --format is only supported with --batch" << endl;
+		return -1;
+	}
+	if (options.benchmark > 0) {
+		const char* unsupported[] = { "static-sync", "shm", "rate", "follow" };
+		for (size_t i = 0; i < sizeof(unsupported) / sizeof(unsupported[0]); ++i) {
+			if (vm.count(unsupported[i])) {
+				cerr << "ERROR: --" << unsupported[i] << " is not supported with --benchmark" << endl;
+				return -1;
+			}
+		}
+	}
+	if (vm.count("batch")) {
+		return 0;
+	}
+
 	if (!vm.count("frames")) {
 		cout << 1 << endl;
 		printHelp(argc, argv, desc);
@@ -77,44 +239,439 @@ int handleArgs(int argc, char **argv, string &frame_target, string &frame_source
 		return -1;
 	}
 
-	frame_source = frames[0];
-	frame_target = frames[1];
-	matrix = vm.count("matrix");
-	quaternion = vm.count("quaternion");
+	options.frameSource = frames[0];
+	options.frameTarget = frames[1];
+	return 0;
+}
+
+void printTransform(const rct::Transform &t, const EchoOptions &options) {
+	if (options.matrix) {
+		cout << "Transformation:\n" << t.getTransform().matrix() << endl;
+	} else if (options.quaternion) {
+		cout << "Translation (x,y,z):\n" << t.getTranslation() << endl;
+		cout << "Rotation (Quat w,x,y,z):\n" << t.getRotationQuat().w() << "\n"
+				<< t.getRotationQuat().x() << "\n" << t.getRotationQuat().y() << "\n"
+				<< t.getRotationQuat().z() << endl;
+	} else {
+		Eigen::Vector3d ypr = t.getRotationYPR();
+		cout << "Translation (x,y,z):\n" << t.getTranslation() << endl;
+		cout << "Rotation (yaw,pitch,roll):\n" << ypr.x() << "\n" << ypr.y() << "\n" << ypr.z()
+				<< endl;
+	}
+}
+
+/**
+ * Resolves the transform from the table of rct-static-publisher's sync
+ * service. Returns false if the service is not reachable or the frames are
+ * not connected by static transforms.
+ */
+bool lookupStatic(const EchoOptions &options, rct::Transform &t) {
+	LoggerPtr logger = Logger::getLogger("rct.RctEcho");
+	try {
+		StaticSyncClient client(rsb::Scope(options.staticSyncScope),
+				rsb::getFactory().getDefaultParticipantConfig());
+		FrameGraph graph;
+		graph.addTransforms(client.fetch());
+		return graph.lookup(options.frameTarget, options.frameSource, t);
+	} catch (std::exception &e) {
+		RSCWARN(logger, "static sync failed: " << e.what());
+		return false;
+	}
+}
+
+/**
+ * Seconds since the epoch with all microseconds. A double printed with the
+ * precision of the stream would be cut to about ten seconds.
+ */
+string formatSeconds(const boost::posix_time::ptime &time) {
+	boost::int64_t micros = (time - boost::posix_time::from_time_t(0)).total_microseconds();
+	stringstream ss;
+	ss << micros / 1000000 << "." << setw(6) << setfill('0') << micros % 1000000;
+	return ss.str();
+}
+
+void printBatchResult(const BatchQuery &query, const rct::Transform *t, const string &error,
+		bool json) {
+	if (json) {
+		cout << "{\"source\":" << jsonString(query.frameSource) << ",\"target\":"
+				<< jsonString(query.frameTarget) << ",\"time\":" << formatSeconds(query.time);
+		if (t) {
+			Eigen::Vector3d p = t->getTranslation();
+			Eigen::Quaterniond q = t->getRotationQuat();
+			cout << ",\"ok\":true,\"stamp\":" << formatSeconds(t->getTime()) << ",\"translation\":["
+					<< p.x() << "," << p.y() << "," << p.z() << "],\"rotation\":[" << q.w() << ","
+					<< q.x() << "," << q.y() << "," << q.z() << "]}";
+		} else {
+			cout << ",\"ok\":false,\"error\":" << jsonString(error) << "}";
+		}
+		cout << endl;
+	} else {
+		cout << query.frameSource << "," << query.frameTarget << "," << formatSeconds(query.time);
+		if (t) {
+			Eigen::Vector3d p = t->getTranslation();
+			Eigen::Quaterniond q = t->getRotationQuat();
+			cout << ",ok," << formatSeconds(t->getTime()) << "," << p.x() << "," << p.y() << ","
+					<< p.z() << "," << q.w() << "," << q.x() << "," << q.y() << "," << q.z() << ",";
+		} else {
+			string message = error;
+			replace(message.begin(), message.end(), ',', ';');
+			replace(message.begin(), message.end(), '\n', ' ');
+			cout << ",error,,,,,,,,," << message;
+		}
+		cout << endl;
+	}
+}
+
+/**
+ * Reads "source_frame target_frame [time]" lines, where time is in seconds
+ * since the epoch. Empty lines and lines starting with '#' are skipped.
+ */
+vector<BatchQuery> readBatch(istream &in) {
+	vector<BatchQuery> queries;
+	string line;
+	unsigned int lineNumber = 0;
+	while (getline(in, line)) {
+		lineNumber++;
+		stringstream ss(line);
+		BatchQuery query;
+		if (!(ss >> query.frameSource) || query.frameSource[0] == '#') {
+			continue;
+		}
+		if (!(ss >> query.frameTarget)) {
+			stringstream error;
+			error << "line " << lineNumber << ": missing target frame";
+			throw runtime_error(error.str());
+		}
+		double seconds;
+		if (ss >> seconds) {
+			query.time = boost::posix_time::from_time_t(0)
+					+ boost::posix_time::microseconds(boost::int64_t(seconds * 1000000.0));
+		} else {
+			query.time = boost::posix_time::microsec_clock::universal_time();
+		}
+		queries.push_back(query);
+	}
+	return queries;
+}
+
+bool loadBatch(const EchoOptions &options, vector<BatchQuery> &queries) {
+	try {
+		if (options.batchFile == "-") {
+			queries = readBatch(cin);
+		} else {
+			ifstream in(options.batchFile.c_str());
+			if (!in.is_open()) {
+				cerr << "ERROR: cannot read " << options.batchFile << endl;
+				return false;
+			}
+			queries = readBatch(in);
+		}
+	} catch (std::exception &e) {
+		cerr << "ERROR: " << e.what() << endl;
+		return false;
+	}
+	return true;
+}
+
+/**
+ * Issues the requests for all frame pairs at once on a single receiver and
+ * prints the results in input order as they become available.
+ */
+int runBatch(const EchoOptions &options, StartupProfiler &profiler) {
+	vector<BatchQuery> queries;
+	if (!loadBatch(options, queries)) {
+		return 1;
+	}
+	profiler.mark("read batch");
+
+	TransformReceiver::Ptr receiver = getTransformerFactory().createTransformReceiver();
+	profiler.mark("create receiver");
+	vector<BatchQuery>::iterator it;
+	for (it = queries.begin(); it != queries.end(); ++it) {
+		it->future = receiver->requestTransform(it->frameTarget, it->frameSource, it->time);
+	}
+	profiler.mark("request transforms");
+	if (options.startupProfile) {
+		profiler.report(cerr);
+	}
+
+	// for translation and rotation, stamps go through formatSeconds()
+	cout << setprecision(9);
+	if (!options.json) {
+		cout << "source,target,time,status,stamp,x,y,z,qw,qx,qy,qz,error" << endl;
+	}
+
+	// all requests share one deadline
+	boost::posix_time::ptime deadline = boost::posix_time::microsec_clock::universal_time()
+			+ boost::posix_time::microseconds(long(options.timeout * 1000000.0));
+	int failed = 0;
+	for (it = queries.begin(); it != queries.end(); ++it) {
+		boost::posix_time::time_duration remaining = deadline
+				- boost::posix_time::microsec_clock::universal_time();
+		try {
+			double timeout = max(0.0, remaining.total_microseconds() / 1000000.0);
+			rct::Transform t = it->future->get(timeout);
+			printBatchResult(*it, &t, "", options.json);
+		} catch (std::exception &e) {
+			printBatchResult(*it, 0, e.what(), options.json);
+			failed++;
+		}
+	}
+	return failed == 0 ? 0 : 1;
+}
+
+void printLatencyRow(const string &pair, const string &mode, LatencyStats &stats) {
+	double seconds = stats.sum() / 1000000000.0;
+	cout << left << setw(32) << pair << setw(8) << mode << right << setw(8) << stats.count()
+			<< fixed << setprecision(1) << setw(12) << stats.min() / 1000.0 << setw(12)
+			<< stats.percentile(0.5) / 1000.0 << setw(12) << stats.percentile(0.99) / 1000.0
+			<< setw(12) << stats.max() / 1000.0 << setw(12)
+			<< (seconds > 0.0 ? stats.count() / seconds : 0.0) << endl;
+}
+
+/**
+ * Measures the latency of the first (cold) request of each frame pair and of
+ * repeated (warm) requests for the latest transform, through the future
+ * interface and through a direct lookup. Each pair gets a fresh receiver, so
+ * that its cold request starts from an empty cache.
+ */
+int runBenchmark(const EchoOptions &options) {
+	vector<BatchQuery> queries;
+	if (!options.batchFile.empty()) {
+		if (!loadBatch(options, queries)) {
+			return 1;
+		}
+	} else {
+		BatchQuery query;
+		query.frameSource = options.frameSource;
+		query.frameTarget = options.frameTarget;
+		queries.push_back(query);
+	}
+
+	cout << left << setw(32) << "pair" << setw(8) << "mode" << right << setw(8) << "n" << setw(12)
+			<< "min [us]" << setw(12) << "p50 [us]" << setw(12) << "p99 [us]" << setw(12)
+			<< "max [us]" << setw(12) << "qps" << endl;
+
+	int failed = 0;
+	vector<BatchQuery>::iterator it;
+	for (it = queries.begin(); it != queries.end(); ++it) {
+		string pair = it->frameSource + " " + it->frameTarget;
+
+		LatencyStats create;
+		boost::uint64_t start = monotonicNanos();
+		TransformReceiver::Ptr receiver = getTransformerFactory().createTransformReceiver();
+		create.add(monotonicNanos() - start);
+		printLatencyRow(pair, "create", create);
+
+		// the latest transform, so that the request does not wait for the next
+		// publication after now
+		LatencyStats cold;
+		try {
+			boost::uint64_t t0 = monotonicNanos();
+			receiver->requestTransform(it->frameTarget, it->frameSource, LATEST)->get(
+					options.timeout);
+			cold.add(monotonicNanos() - t0);
+		} catch (std::exception &e) {
+			cerr << "ERROR: " << pair << ": " << e.what() << endl;
+			failed++;
+			continue;
+		}
+		printLatencyRow(pair, "cold", cold);
+
+		LatencyStats future;
+		LatencyStats lookup;
+		try {
+			for (unsigned int i = 0; i < options.benchmark; ++i) {
+				boost::uint64_t t0 = monotonicNanos();
+				receiver->requestTransform(it->frameTarget, it->frameSource, LATEST)->get(
+						options.timeout);
+				future.add(monotonicNanos() - t0);
+			}
+			for (unsigned int i = 0; i < options.benchmark; ++i) {
+				boost::uint64_t t0 = monotonicNanos();
+				receiver->lookupTransform(it->frameTarget, it->frameSource, LATEST);
+				lookup.add(monotonicNanos() - t0);
+			}
+		} catch (std::exception &e) {
+			cerr << "ERROR: " << pair << ": " << e.what() << endl;
+			failed++;
+		}
+		printLatencyRow(pair, "future", future);
+		printLatencyRow(pair, "lookup", lookup);
+	}
+	return failed == 0 ? 0 : 1;
+}
+
+/**
+ * Resolves the transform from the shared memory snapshot of rct-daemon
+ * without joining the middleware. With a rate, polls the snapshot until
+ * interrupted.
+ */
+int runSnapshot(const EchoOptions &options, StartupProfiler &profiler) {
+	TransformSnapshotReader::Ptr reader;
+	try {
+		reader = TransformSnapshotReader::Ptr(new TransformSnapshotReader(options.snapshot));
+	} catch (std::exception &e) {
+		cerr << "ERROR: " << e.what() << endl;
+		return 1;
+	}
+	profiler.mark("map snapshot");
+	if (options.startupProfile) {
+		profiler.report(cerr);
+	}
+	if (!reader->writerAlive()) {
+		cerr << "WARNING: the process writing " << options.snapshot << " has terminated" << endl;
+	}
+
+	signal(SIGINT, signalHandler);
+	signal(SIGTERM, signalHandler);
+	boost::posix_time::ptime deadline = boost::posix_time::microsec_clock::universal_time();
+	boost::posix_time::time_duration period = boost::posix_time::microseconds(
+			options.rate > 0.0 ? long(1000000.0 / options.rate) : 0);
+	do {
+		rct::Transform t;
+		try {
+			FrameGraph graph;
+			graph.addTransforms(reader->transforms());
+			if (!graph.lookup(options.frameTarget, options.frameSource, t)) {
+				cerr << "ERROR: " << options.frameSource << " and " << options.frameTarget
+						<< " are not connected in " << options.snapshot << endl;
+				if (options.rate <= 0.0) {
+					return 1;
+				}
+			} else {
+				if (options.rate > 0.0) {
+					cout << "At time " << boost::posix_time::to_iso_extended_string(t.getTime())
+							<< endl;
+				}
+				printTransform(t, options);
+			}
+		} catch (std::exception &e) {
+			cerr << "ERROR: " << e.what() << endl;
+			return 1;
+		}
+		if (options.rate > 0.0) {
+			deadline += period;
+			boost::this_thread::sleep(deadline);
+		}
+	} while (running && options.rate > 0.0);
+	return 0;
+}
+
+/**
+ * Keeps the receiver alive and prints the transform at a fixed rate or on
+ * every change until interrupted. Once the first transform arrived, the
+ * latest one is looked up directly from the warm cache.
+ */
+int runContinuous(const EchoOptions &options, StartupProfiler &profiler) {
+	LoggerPtr logger = Logger::getLogger("rct.RctEcho");
+	signal(SIGINT, signalHandler);
+	signal(SIGTERM, signalHandler);
+
+	ChangeNotifier::Ptr notifier(new ChangeNotifier());
+	TransformReceiver::Ptr receiver = getTransformerFactory().createTransformReceiver(notifier);
+	profiler.mark("create receiver");
+
+	// wait for the cache to become warm
+	while (running) {
+		boost::posix_time::ptime now(boost::posix_time::microsec_clock::universal_time());
+		TransformReceiver::FuturePtr future = receiver->requestTransform(options.frameTarget,
+				options.frameSource, now);
+		try {
+			future->get(options.timeout);
+			break;
+		} catch (std::exception &e) {
+			RSCWARN(logger, "still waiting for transform: " << e.what());
+		}
+	}
+	profiler.mark("first transform");
+	if (options.startupProfile) {
+		profiler.report(cerr);
+	}
+
+	boost::posix_time::ptime lastTime;
+	unsigned long seenUpdates = 0;
+	boost::posix_time::ptime deadline = boost::posix_time::microsec_clock::universal_time();
+	boost::posix_time::time_duration period = boost::posix_time::microseconds(
+			options.rate > 0.0 ? long(1000000.0 / options.rate) : 0);
+
+	while (running) {
+		if (options.rate > 0.0) {
+			deadline += period;
+			boost::this_thread::sleep(deadline);
+		} else {
+			seenUpdates = notifier->waitForUpdate(seenUpdates, 0.5);
+		}
+		if (!running) {
+			break;
+		}
+
+		rct::Transform t;
+		try {
+			t = receiver->lookupTransform(options.frameTarget, options.frameSource, LATEST);
+		} catch (std::exception &e) {
+			RSCDEBUG(logger, "lookup failed: " << e.what());
+			continue;
+		}
+		if (options.rate <= 0.0 && t.getTime() == lastTime) {
+			continue;
+		}
+		lastTime = t.getTime();
+		cout << "At time " << boost::posix_time::to_iso_extended_string(t.getTime()) << endl;
+		printTransform(t, options);
+	}
 	return 0;
 }
 
 int main(int argc, char **argv) {
+	StartupProfiler profiler;
 
-	string frameTgt, frameSrc;
-	bool matrix, quaternion;
+	EchoOptions options;
 
-	int ret = handleArgs(argc, argv, frameTgt, frameSrc, matrix, quaternion);
+	int ret = handleArgs(argc, argv, options);
 	if (ret != 0) {
 		return ret;
 	}
+	profiler.mark("options");
+
+	if (!options.staticSyncScope.empty()) {
+		rct::Transform t;
+		if (lookupStatic(options, t)) {
+			printTransform(t, options);
+			return 0;
+		}
+	}
+
+	if (!options.snapshot.empty()) {
+		return runSnapshot(options, profiler);
+	}
+
+	if (options.benchmark > 0) {
+		return runBenchmark(options);
+	}
+
+	if (!options.batchFile.empty()) {
+		return runBatch(options, profiler);
+	}
+
+	if (options.rate > 0.0 || options.follow) {
+		return runContinuous(options, profiler);
+	}
 
 	boost::posix_time::ptime now(boost::posix_time::microsec_clock::universal_time());
 
 	TransformReceiver::Ptr transformerRsb = getTransformerFactory().createTransformReceiver();
-	TransformReceiver::FuturePtr future = transformerRsb->requestTransform(frameTgt, frameSrc, now);
+	profiler.mark("create receiver");
+	TransformReceiver::FuturePtr future = transformerRsb->requestTransform(options.frameTarget,
+			options.frameSource, now);
 
 	try {
-		rct::Transform t = future->get(2.0);
-
-		if (matrix) {
-			cout << "Transformation:\n" << t.getTransform().matrix() << endl;
-		} else if (quaternion) {
-			cout << "Translation (x,y,z):\n" << t.getTranslation() << endl;
-			cout << "Rotation (Quat w,x,y,z):\n" << t.getRotationQuat().w() << "\n"
-					<< t.getRotationQuat().x() << "\n" << t.getRotationQuat().y() << "\n"
-					<< t.getRotationQuat().z() << endl;
-		} else {
-			Eigen::Vector3d ypr = t.getRotationYPR();
-			cout << "Translation (x,y,z):\n" << t.getTranslation() << endl;
-			cout << "Rotation (yaw,pitch,roll):\n" << ypr.x() << "\n" << ypr.y() << "\n" << ypr.z()
-					<< endl;
+		rct::Transform t = future->get(options.timeout);
+		profiler.mark("first transform");
+		if (options.startupProfile) {
+			profiler.report(cerr);
 		}
+		printTransform(t, options);
 		return 0;
 	} catch (std::exception &e) {
 		cerr << "ERROR: " << e.what() << endl;
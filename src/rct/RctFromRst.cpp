@@ -6,10 +6,14 @@
  */
 
 #include <rct/rctConfig.h>
-#include <rct/impl/TransformCommRsb.h>
 
+#include "convert/PoseConverter.h"
+#include "convert/PublisherCommunicator.h"
 #include "parsers/ParserINI.h"
 #include "parsers/ParserXML.h"
+#include "util/AllocationCounter.h"
+#include "util/Realtime.h"
+#include "util/StartupProfiler.h"
 #include <rct/rct.h>
 
 #include <boost/program_options.hpp>
@@ -22,87 +26,15 @@
 #include <iostream>
 #include <csignal>
 
-#include <rsb/Handler.h>
-#include <rsb/Listener.h>
-#include <rsb/MetaData.h>
-#include <rsb/Factory.h>
-#include <rsb/converter/ProtocolBufferConverter.h>
-#include <rsb/converter/Repository.h>
-
-#include <rst/geometry/Pose.pb.h>
-
 using namespace boost::program_options;
 using namespace boost::filesystem;
 using namespace std;
 using namespace rsc::logging;
-using namespace rsb;
-using namespace rsb::converter;
-using namespace rst::geometry;
 using namespace rct;
 
-TransformPublisher::Ptr publisher;
-map<Scope, ParserResultMessage> messageMapping;
 LoggerPtr logger = Logger::getLogger("rct.RctFromRst");
 
-Converter<string>::Ptr converterPose;
-
-void handlePose(boost::shared_ptr<Pose> p, ParserResultMessage message, boost::uint64_t time_usec) {
-
-	boost::posix_time::ptime time(boost::gregorian::date(1970,1,1));
-	time += boost::posix_time::microseconds(time_usec);
-
-	// read data
-	double x = p->translation().x();
-	double y = p->translation().y();
-	double z = p->translation().z();
-	double qw =p->rotation().qw();
-	double qx =p->rotation().qx();
-	double qy =p->rotation().qy();
-	double qz =p->rotation().qz();
-
-	// create a transform
-	Eigen::Vector3d translation(x,y,z);
-	Eigen::Quaterniond rotation(qw,qx,qy,qz);
-	Eigen::Affine3d affine = Eigen::Affine3d().fromPositionOrientationScale(translation, rotation,
-						Eigen::Vector3d::Ones());
-	rct::Transform transform(affine, message.parent, message.child, time);
-	transform.setAuthority(message.authority);
-
-	// publish the transform
-	publisher->sendTransform(transform, rct::DYNAMIC);
-}
-
-void handleEvent(EventPtr e) {
-
-	// find message for source
-	Scope scope = e->getScope();
-	boost::uint64_t time_usec = e->getMetaData().getCreateTime();
-	ParserResultMessage message;
-	map<Scope, ParserResultMessage>::iterator msgIt;
-	for (msgIt = messageMapping.begin(); msgIt != messageMapping.end(); ++msgIt) {
-		if (msgIt->first == scope || msgIt->first.isSuperScopeOf(scope)) {
-			message = msgIt->second;
-			break;
-		}
-	}
-	if (message.scope.empty()) {
-		RSCERROR(logger, "No known message configuration for scope: " << scope);
-		return;
-	}
-
-	if (e->getType() == converterPose->getDataType()) {
-		handlePose(boost::static_pointer_cast<Pose>(e->getData()), message, time_usec);
-	}
-}
-
-void createMessageMapping(vector<ParserResultMessage> messages) {
-	vector<ParserResultMessage>::iterator msgIt;
-	for (msgIt = messages.begin(); msgIt != messages.end(); ++msgIt) {
-		messageMapping[Scope(msgIt->scope)] = *msgIt;
-	}
-}
-
-void parse(const string &configFile) {
+vector<ParserResultMessage> parse(const string &configFile, StartupProfiler &profiler) {
 
 	std::vector<Parser::Ptr> parsers;
 	parsers.push_back(rct::ParserINI::Ptr(new rct::ParserINI()));
@@ -110,28 +42,40 @@ void parse(const string &configFile) {
 
 	RSCDEBUG(logger, "reading config file: " << configFile)
 	vector<ParserResultMessage> result;
+	Parser::Ptr parser;
 	vector<Parser::Ptr>::iterator it;
 	for (it = parsers.begin(); it != parsers.end(); ++it) {
-		Parser::Ptr p = *it;
-		if (p->canParse(configFile)) {
-			result = p->parseConvertMessages(configFile);
+		if ((*it)->canParse(configFile)) {
+			parser = *it;
 			break;
 		}
 	}
+	profiler.mark("config canParse");
+	if (parser) {
+		result = parser->parseConvertMessages(configFile);
+	}
+	profiler.mark("config parse");
 
-	createMessageMapping(result);
+	return result;
 }
 
 int main(int argc, char **argv) {
+	StartupProfiler profiler;
 	options_description desc("Allowed options");
 	variables_map vm;
 
 	desc.add_options()("help,h", "produce help message") // help
 	("config,c", value<string>(), "a single config file") // config file
+	("stale-factor", value<double>(),
+			"warn about dynamic edges not updated for this many mean publish intervals") // stale factor
+	("stale-timeout", value<double>(), "warn about dynamic edges not updated for this time (seconds)") // stale timeout
+	("startup-profile", "print the time spent in each startup phase once started") // startup profile
 	("debug", "debug mode") //debug
 	("trace", "trace mode") //trace
 	("info", "info mode")("log-prop,l", value<string>(), "logging properties");
 
+	desc.add(RealtimeOptions::description());
+
 	store(parse_command_line(argc, argv, desc), vm);
 	notify(vm);
 
@@ -161,28 +105,47 @@ int main(int argc, char **argv) {
 	}
 
 	rsc::misc::initSignalWaiter();
+	profiler.mark("options");
 
 	try {
 
-		parse(configFile);
-		publisher = getTransformerFactory().createTransformPublisher(name);
-
-		converterPose = Converter<string>::Ptr(new ProtocolBufferConverter<Pose>());
-		converterRepository<string>()->registerConverter(converterPose);
-
-		vector<ListenerPtr> listeners;
-		Factory& factory = getFactory();
-		map<Scope, ParserResultMessage>::iterator msgIt;
-		for (msgIt = messageMapping.begin(); msgIt != messageMapping.end(); ++msgIt) {
-			Scope scope = msgIt->first;
-			ParserResultMessage msg = msgIt->second;
-			cout << msg.parent << msg.child << msg.scope << msg.authority << endl;
-			ListenerPtr listener = factory.createListener(scope);
-			listener->addHandler(HandlerPtr(new EventFunctionHandler(&handleEvent)));
-			listeners.push_back(listener);
+		vector<ParserResultMessage> messages = parse(configFile, profiler);
+		// before the communicator, so that the rsb threads inherit it
+		RealtimeOptions realtime(vm);
+		realtime.apply();
+		WakeupLatencyMonitor::Ptr wakeup;
+		if (realtime.reportWakeupLatency()) {
+			wakeup = WakeupLatencyMonitor::Ptr(
+					new WakeupLatencyMonitor(cerr, realtime.wakeupReportInterval));
+		}
+		profiler.mark("real-time setup");
+		// through the factory, so that its configuration applies as before
+		TransformCommunicator::Ptr comm(
+				new PublisherCommunicator(getTransformerFactory().createTransformPublisher(name)));
+		profiler.mark("create communicator");
+
+		PoseConverter::registerConverters();
+		profiler.mark("register converters");
+		PoseConverter converter(comm);
+		converter.addMessages(messages);
+		StalenessWatchdog::Ptr watchdog;
+		if (vm.count("stale-factor") || vm.count("stale-timeout")) {
+			watchdog = StalenessWatchdog::Ptr(
+					new StalenessWatchdog(vm.count("stale-factor") ? vm["stale-factor"].as<double>() : 0.0,
+							vm.count("stale-timeout") ? vm["stale-timeout"].as<double>() : 0.0));
+			converter.setWatchdog(watchdog);
+		}
+		converter.start();
+		profiler.mark("create listeners");
+		if (vm.count("startup-profile")) {
+			profiler.report(cerr);
 		}
 
-		return rsc::misc::suggestedExitCode(rsc::misc::waitForSignal());
+		int ret = rsc::misc::suggestedExitCode(rsc::misc::waitForSignal());
+#ifdef RCT_ALLOC_ACCOUNTING
+		AllocationCounter::report(cerr);
+#endif
+		return ret;
 
 	} catch (std::exception &e) {
 		cerr << "Error:\n  " << e.what() << "\n" << endl;
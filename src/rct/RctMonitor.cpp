@@ -0,0 +1,152 @@
+/*
+ * RctMonitor.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: lziegler
+ */
+#include <rct/rctConfig.h>
+#include <rct/TransformerFactory.h>
+#include "monitor/EdgeMonitor.h"
+#include "util/Clock.h"
+#include "util/StartupProfiler.h"
+#include <boost/program_options.hpp>
+#include <rsc/logging/Logger.h>
+#include <csignal>
+#include <iomanip>
+#include <iostream>
+#include <unistd.h>
+
+using namespace boost::program_options;
+using namespace std;
+using namespace rct;
+using namespace rsc::logging;
+
+bool running = true;
+
+void signalHandler(int signum) {
+	running = false;
+}
+
+void printHelp(int argc, char **argv, options_description desc) {
+	cout << "Usage:\n  " << argv[0] << " [options]\n" << endl;
+	cout << desc << endl;
+	cout << "This will print the publish rate, jitter, delay between" << endl;
+	cout << "stamp and receipt and the authority of every edge of" << endl;
+	cout << "the transform graph. Stale dynamic edges are highlighted." << endl;
+}
+
+void printTable(const vector<EdgeInfo> &edges, double staleFactor, double staleTimeout,
+		bool showStatic, bool color) {
+	boost::uint64_t now = monotonicNanos();
+
+	cout << left << setw(24) << "parent" << setw(24) << "child" << setw(20) << "authority"
+			<< setw(8) << "type" << right << setw(10) << "rate [Hz]" << setw(12) << "jitter [ms]"
+			<< setw(12) << "delay [ms]" << setw(12) << "max [ms]" << setw(10) << "age [s]" << endl;
+
+	unsigned int shown = 0;
+	unsigned int stale = 0;
+	vector<EdgeInfo>::const_iterator it;
+	for (it = edges.begin(); it != edges.end(); ++it) {
+		if (it->isStatic && !showStatic) {
+			continue;
+		}
+		shown++;
+		bool isStale = EdgeMonitor::isStale(*it, now, staleFactor, staleTimeout);
+		if (isStale) {
+			stale++;
+			if (color) {
+				cout << "\033[31m";
+			}
+		}
+		cout << left << setw(24) << it->parent << setw(24) << it->child << setw(20)
+				<< it->authority << setw(8) << (isStale ? "STALE" : (it->isStatic ? "static" : "dynamic"))
+				<< right << fixed << setprecision(1);
+		if (it->isStatic) {
+			cout << setw(10) << "-" << setw(12) << "-" << setw(12) << "-" << setw(12) << "-";
+		} else {
+			cout << setw(10) << it->rate() << setprecision(2) << setw(12) << it->jitter * 1000.0
+					<< setw(12) << it->meanDelay * 1000.0 << setw(12) << it->maxDelay * 1000.0;
+		}
+		cout << setprecision(1) << setw(10) << it->age(now);
+		if (isStale && color) {
+			cout << "\033[0m";
+		}
+		cout << endl;
+	}
+	cout << shown << " edges, " << stale << " stale\n" << endl;
+}
+
+int main(int argc, char **argv) {
+	StartupProfiler profiler;
+
+	options_description desc("Allowed options");
+	variables_map vm;
+
+	desc.add_options()("help,h", "produce help message") // help
+	("debug", "debug mode") //debug
+	("trace", "trace mode") //trace
+	("interval", value<double>()->default_value(1.0), "report interval (seconds)") // interval
+	("stale-factor", value<double>()->default_value(5.0),
+			"dynamic edges are stale after this many mean publish intervals") // stale factor
+	("stale-timeout", value<double>(), "dynamic edges are stale after this time (seconds)") // stale timeout
+	("no-static", "hide static edges") // static
+	("no-color", "do not highlight stale edges") // color
+	("once", "print a single report after the first interval") // once
+	("startup-profile", "print the time spent in each startup phase once started") // startup profile
+	("info", "info mode");
+
+	store(command_line_parser(argc, argv).options(desc).run(), vm);
+	notify(vm);
+
+	if (vm.count("help")) {
+		printHelp(argc, argv, desc);
+		return 0;
+	}
+
+	Logger::getLogger("")->setLevel(Logger::LEVEL_WARN);
+	if (vm.count("debug")) {
+		Logger::getLogger("rct")->setLevel(Logger::LEVEL_DEBUG);
+	} else if (vm.count("trace")) {
+		Logger::getLogger("rct")->setLevel(Logger::LEVEL_TRACE);
+	} else if (vm.count("info")) {
+		Logger::getLogger("rct")->setLevel(Logger::LEVEL_INFO);
+	}
+
+	double interval = vm["interval"].as<double>();
+	double staleFactor = vm["stale-factor"].as<double>();
+	double staleTimeout = 0.0;
+	if (vm.count("stale-timeout")) {
+		staleTimeout = vm["stale-timeout"].as<double>();
+	}
+	bool color = !vm.count("no-color") && isatty(STDOUT_FILENO);
+
+	signal(SIGINT, signalHandler);
+	signal(SIGTERM, signalHandler);
+	profiler.mark("options");
+
+	try {
+		EdgeMonitor::Ptr monitor(new EdgeMonitor());
+		TransformReceiver::Ptr receiver = getTransformerFactory().createTransformReceiver(monitor);
+		profiler.mark("create receiver");
+		if (vm.count("startup-profile")) {
+			profiler.report(cerr);
+		}
+
+		while (running) {
+			usleep(interval * 1000000.0);
+			if (!running) {
+				break;
+			}
+			printTable(monitor->snapshot(), staleFactor, staleTimeout, !vm.count("no-static"),
+					color);
+			monitor->resetMaxima();
+			if (vm.count("once")) {
+				break;
+			}
+		}
+	} catch (std::exception &e) {
+		cerr << "Error:\n  " << e.what() << "\n" << endl;
+		return 1;
+	}
+	return 0;
+}
@@ -0,0 +1,101 @@
+/*
+ * RctRecord.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: lziegler
+ */
+
+#include "log/TransformLog.h"
+#include "util/Clock.h"
+#include "util/StartupProfiler.h"
+#include <rct/rct.h>
+
+#include <boost/program_options.hpp>
+#include <rsc/logging/Logger.h>
+#include <rsc/logging/LoggerFactory.h>
+#include <iostream>
+#include <csignal>
+
+using namespace boost::program_options;
+using namespace std;
+using namespace rsc::logging;
+using namespace rct;
+
+volatile sig_atomic_t running = 1;
+
+void signalHandler(int signum) {
+	running = 0;
+}
+
+int main(int argc, char **argv) {
+	StartupProfiler profiler;
+	options_description desc("Allowed options");
+	variables_map vm;
+
+	desc.add_options()("help,h", "produce help message") // help
+	("output,o", value<string>()->default_value("transforms.rctlog"), "log file to write") // output
+	("duration,d", value<double>()->default_value(0.0),
+			"stop after this time, 0 records until interrupted (seconds)") // duration
+	("startup-profile", "print the time spent in each startup phase once recording") // startup profile
+	("debug", "debug mode") //debug
+	("trace", "trace mode") //trace
+	("info", "info mode")("log-prop,l", value<string>(), "logging properties");
+
+	store(parse_command_line(argc, argv, desc), vm);
+	notify(vm);
+
+	if (vm.count("help")) {
+		cout << "Usage:\n  " << argv[0] << " [options]\n" << endl;
+		cout << desc << endl;
+		cout << "Records all transforms into a binary log for rct-replay." << endl;
+		return 0;
+	}
+
+	Logger::getLogger("")->setLevel(Logger::LEVEL_WARN);
+	if (vm.count("debug")) {
+		Logger::getLogger("rct")->setLevel(Logger::LEVEL_DEBUG);
+	} else if (vm.count("trace")) {
+		Logger::getLogger("rct")->setLevel(Logger::LEVEL_TRACE);
+	} else if (vm.count("info")) {
+		Logger::getLogger("rct")->setLevel(Logger::LEVEL_INFO);
+	} else if (vm.count("log-prop")) {
+		string properties = vm["log-prop"].as<string>();
+		cout << "Using logging properties: " << properties << endl;
+		LoggerFactory::getInstance().reconfigureFromFile(properties);
+	}
+
+	signal(SIGINT, signalHandler);
+	signal(SIGTERM, signalHandler);
+	profiler.mark("options");
+
+	try {
+		string file = vm["output"].as<string>();
+		double duration = vm["duration"].as<double>();
+
+		TransformLogWriter::Ptr writer(new TransformLogWriter(file));
+		profiler.mark("open log");
+		TransformReceiver::Ptr receiver = getTransformerFactory().createTransformReceiver(writer);
+		profiler.mark("create receiver");
+		cerr << "recording to " << file << endl;
+		if (vm.count("startup-profile")) {
+			profiler.report(cerr);
+		}
+
+		boost::uint64_t start = monotonicNanos();
+		boost::uint64_t end = start + boost::uint64_t(duration * 1000000000.0);
+		while (running && (duration <= 0.0 || monotonicNanos() < end)) {
+			usleep(100000);
+		}
+
+		// no more transforms once the log is closed
+		writer->close();
+		double elapsed = (monotonicNanos() - start) / 1000000000.0;
+		cerr << "recorded " << writer->recordCount() << " transforms (" << writer->byteCount()
+				<< " bytes) in " << elapsed << " s" << endl;
+
+	} catch (std::exception &e) {
+		cerr << "Error:\n  " << e.what() << "\n" << endl;
+		return 1;
+	}
+	return 0;
+}
@@ -0,0 +1,185 @@
+/*
+ * RctReplay.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: lziegler
+ */
+
+#include "log/TransformLog.h"
+#include "util/Clock.h"
+#include "util/StartupProfiler.h"
+#include <rct/rct.h>
+
+#include <boost/program_options.hpp>
+#include <rsc/logging/Logger.h>
+#include <rsc/logging/LoggerFactory.h>
+#include <iostream>
+#include <csignal>
+#include <time.h>
+
+using namespace boost::program_options;
+using namespace std;
+using namespace rsc::logging;
+using namespace rct;
+
+volatile sig_atomic_t running = 1;
+
+void signalHandler(int signum) {
+	running = 0;
+}
+
+void sleepUntil(boost::uint64_t nanos) {
+	struct timespec ts;
+	ts.tv_sec = nanos / 1000000000ull;
+	ts.tv_nsec = nanos % 1000000000ull;
+	while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL) != 0 && running) {
+	}
+}
+
+int main(int argc, char **argv) {
+	StartupProfiler profiler;
+	positional_options_description p;
+	p.add("file", 1);
+
+	options_description desc("Allowed options");
+	variables_map vm;
+
+	desc.add_options()("help,h", "produce help message") // help
+	("name,n", value<string>()->default_value("rct-replay"), "name of the publisher") // name
+	("speed,s", value<double>()->default_value(1.0), "replay speed relative to the recording") // speed
+	("max", "replay as fast as possible") // max
+	("start", value<double>()->default_value(0.0),
+			"skip this much of the recording (seconds)") // start
+	("loop", "start over at the end of the log") // loop
+	("original-stamps",
+			"keep the recorded stamps instead of shifting them to the replay time") // stamps
+	("startup-profile", "print the time spent in each startup phase before replaying") // startup profile
+	("debug", "debug mode") //debug
+	("trace", "trace mode") //trace
+	("info", "info mode")("log-prop,l", value<string>(), "logging properties");
+
+	options_description hidden("Hidden options");
+	hidden.add_options()("file", value<string>(), "log file");
+	options_description all;
+	all.add(desc).add(hidden);
+
+	store(command_line_parser(argc, argv).options(all).positional(p).run(), vm);
+	notify(vm);
+
+	if (vm.count("help") || !vm.count("file")) {
+		cout << "Usage:\n  " << argv[0] << " [options] file\n" << endl;
+		cout << desc << endl;
+		cout << "Publishes a log of rct-record with its original timing, scaled by --speed."
+				<< endl;
+		return vm.count("help") ? 0 : 1;
+	}
+
+	Logger::getLogger("")->setLevel(Logger::LEVEL_WARN);
+	if (vm.count("debug")) {
+		Logger::getLogger("rct")->setLevel(Logger::LEVEL_DEBUG);
+	} else if (vm.count("trace")) {
+		Logger::getLogger("rct")->setLevel(Logger::LEVEL_TRACE);
+	} else if (vm.count("info")) {
+		Logger::getLogger("rct")->setLevel(Logger::LEVEL_INFO);
+	} else if (vm.count("log-prop")) {
+		string properties = vm["log-prop"].as<string>();
+		cout << "Using logging properties: " << properties << endl;
+		LoggerFactory::getInstance().reconfigureFromFile(properties);
+	}
+
+	double speed = vm["speed"].as<double>();
+	if (speed <= 0.0) {
+		cerr << "Error:\n  --speed must be positive\n" << endl;
+		return 1;
+	}
+	bool maxSpeed = vm.count("max");
+	bool loop = vm.count("loop");
+	bool originalStamps = vm.count("original-stamps");
+	boost::uint64_t skip = boost::uint64_t(vm["start"].as<double>() * 1000000000.0);
+
+	signal(SIGINT, signalHandler);
+	signal(SIGTERM, signalHandler);
+	profiler.mark("options");
+
+	try {
+		TransformLogReader reader(vm["file"].as<string>());
+		profiler.mark("map log");
+		TransformPublisher::Ptr publisher = getTransformerFactory().createTransformPublisher(
+				vm["name"].as<string>());
+		profiler.mark("create publisher");
+		if (vm.count("startup-profile")) {
+			profiler.report(cerr);
+		}
+
+		unsigned long sent = 0;
+		boost::uint64_t maxLateness = 0;
+		// static transforms are only sent once, so those recorded before the
+		// start go out first in every pass
+		vector<TransformLogRecord> statics;
+		if (skip > 0) {
+			statics = reader.staticsBefore(skip);
+		}
+		boost::uint64_t replayStart = monotonicNanos();
+		do {
+			reader.seek(skip);
+			TransformLogRecord record;
+			if (!reader.next(record)) {
+				cerr << "no transforms in the log after " << skip / 1000000000.0 << " s" << endl;
+				break;
+			}
+
+			// the first record of each pass is sent right away
+			boost::uint64_t passStart = monotonicNanos();
+			boost::uint64_t firstReceipt = record.receipt;
+			// anchored on receipt, since the first stamp may be that of an old
+			// static transform
+			boost::posix_time::time_duration stampShift;
+			if (!originalStamps) {
+				stampShift = boost::posix_time::microsec_clock::universal_time()
+						- (reader.recordingStart() + boost::posix_time::microseconds(firstReceipt / 1000));
+			}
+			vector<TransformLogRecord>::const_iterator it;
+			for (it = statics.begin(); it != statics.end(); ++it) {
+				Transform transform = it->transform;
+				if (!originalStamps) {
+					transform.setTime(transform.getTime() + stampShift);
+				}
+				publisher->sendTransform(transform, rct::STATIC);
+				sent++;
+			}
+			do {
+				boost::uint64_t deadline = passStart
+						+ boost::uint64_t((record.receipt - firstReceipt) / speed);
+				if (!maxSpeed) {
+					sleepUntil(deadline);
+					boost::uint64_t now = monotonicNanos();
+					if (now > deadline) {
+						maxLateness = max(maxLateness, now - deadline);
+					}
+				}
+				if (!running) {
+					break;
+				}
+				if (!originalStamps) {
+					record.transform.setTime(record.transform.getTime() + stampShift);
+				}
+				publisher->sendTransform(record.transform,
+						record.isStatic ? rct::STATIC : rct::DYNAMIC);
+				sent++;
+			} while (running && reader.next(record));
+		} while (running && loop);
+
+		double elapsed = (monotonicNanos() - replayStart) / 1000000000.0;
+		cerr << "sent " << sent << " transforms in " << elapsed << " s (" << sent / elapsed
+				<< " /s)";
+		if (!maxSpeed) {
+			cerr << ", max schedule lateness " << nanosToMillis(maxLateness) << " ms";
+		}
+		cerr << endl;
+
+	} catch (std::exception &e) {
+		cerr << "Error:\n  " << e.what() << "\n" << endl;
+		return 1;
+	}
+	return 0;
+}
@@ -5,7 +5,10 @@
  *      Author: leon
  */
 
-#include "RctRosBridge.h"
+#include "bridge/RctRosBridge.h"
+#include "util/AllocationCounter.h"
+#include "util/Realtime.h"
+#include "util/StartupProfiler.h"
 #include <rct/rctConfig.h>
 #include <rct/impl/TransformCommRsb.h>
 #include <rct/impl/TransformCommRos.h>
@@ -34,6 +37,7 @@ void signalHandler(int signum) {
 }
 
 int main(int argc, char **argv) {
+	rct::StartupProfiler profiler;
 	options_description desc("Allowed options");
 	variables_map vm;
 
@@ -41,8 +45,20 @@ int main(int argc, char **argv) {
 	("debug", "debug mode") //debug
 	("trace", "trace mode") //trace
 	("info", "info mode")
+	("static-snapshot", value<string>(),
+			"keep the bridged static transforms in this file and republish them on startup") // snapshot
+	("static-snapshot-interval", value<long>()->default_value(rct::StaticTransformStore::DEFAULT_INTERVAL_MSEC),
+			"minimum time between two writes of the snapshot (msec)") // snapshot interval
+	("static-snapshot-grace", value<long>()->default_value(rct::StaticTransformStore::DEFAULT_GRACE_MSEC),
+			"drop restored transforms not bridged again within this time after startup (msec)") // snapshot grace
+	("stale-factor", value<double>(),
+			"warn about dynamic edges not updated for this many mean publish intervals") // stale factor
+	("stale-timeout", value<double>(), "warn about dynamic edges not updated for this time (seconds)") // stale timeout
+	("startup-profile", "print the time spent in each startup phase once started") // startup profile
 	("log-prop,l", value<string>(), "logging properties file");
 
+	desc.add(rct::RealtimeOptions::description());
+
 	store(parse_command_line(argc, argv, desc), vm);
 	notify(vm);
 
@@ -63,24 +79,61 @@ int main(int argc, char **argv) {
 		cout << "Using logging properties: " << properties << endl;
 		LoggerFactory::getInstance().reconfigureFromFile(properties);
 	}
+	profiler.mark("options");
 
 	try {
 
+		// before the communicators and the spinner, so that their threads
+		// inherit it; run() forwards on this thread
+		rct::RealtimeOptions realtime(vm);
+		realtime.apply();
+		rct::WakeupLatencyMonitor::Ptr wakeup;
+		if (realtime.reportWakeupLatency()) {
+			wakeup = rct::WakeupLatencyMonitor::Ptr(
+					new rct::WakeupLatencyMonitor(cerr, realtime.wakeupReportInterval));
+		}
+		profiler.mark("real-time setup");
+
 		map<string, string> remappings;
 		ros::init(argc, argv, "rctrosbridge");
+		profiler.mark("ros::init");
 
 		bridge = new rct::RctRosBridge("rctrosbridge");
+		profiler.mark("create rsb and ros communicators");
+
+		if (vm.count("static-snapshot")) {
+			bridge->setStaticStore(
+					rct::StaticTransformStore::Ptr(
+							new rct::StaticTransformStore(vm["static-snapshot"].as<string>(),
+									vm["static-snapshot-interval"].as<long>(),
+									vm["static-snapshot-grace"].as<long>())));
+			profiler.mark("load static snapshot");
+		}
+		if (vm.count("stale-factor") || vm.count("stale-timeout")) {
+			bridge->setWatchdog(
+					rct::StalenessWatchdog::Ptr(
+							new rct::StalenessWatchdog(
+									vm.count("stale-factor") ? vm["stale-factor"].as<double>() : 0.0,
+									vm.count("stale-timeout") ? vm["stale-timeout"].as<double>() : 0.0)));
+		}
 
 		// register signal SIGINT and signal handler
 		signal(SIGINT, signalHandler);
 
 		ros::AsyncSpinner spinner(4);
 		spinner.start();
+		profiler.mark("start spinner");
 
 		cout << "successfully started" << endl;
+		if (vm.count("startup-profile")) {
+			profiler.report(cerr);
+		}
 
 		// block
 		bool ret = bridge->run();
+#ifdef RCT_ALLOC_ACCOUNTING
+		rct::AllocationCounter::report(cerr);
+#endif
 
 		if (!ret) {
 			cout << "done" << endl;
@@ -92,134 +145,3 @@ int main(int argc, char **argv) {
 		return 1;
 	}
 }
-
-namespace rct {
-
-rsc::logging::LoggerPtr RctRosBridge::logger = rsc::logging::Logger::getLogger("rct.RctRosBridge");
-
-RctRosBridge::RctRosBridge(const string &name, bool rosLegacyMode, long rosLegacyIntervalMSec) :
-		interrupted(false) {
-
-	rosHandler = Handler::Ptr(new Handler(this, "Ros"));
-	rsbHandler = Handler::Ptr(new Handler(this, "Rsb"));
-
-	TransformerConfig configRsb;
-	configRsb.setCommType(TransformerConfig::RSB);
-	commRsb = TransformCommRsb::Ptr(new TransformCommRsb(name, rsbHandler));
-	commRsb->init(configRsb);
-
-	TransformerConfig configRos;
-	configRos.setCommType(TransformerConfig::ROS);
-	commRos = TransformCommRos::Ptr(new TransformCommRos(name, configRos.getCacheTime(), rosHandler, rosLegacyMode, rosLegacyIntervalMSec));
-	commRos->init(configRos);
-}
-
-void RctRosBridge::notify() {
-	boost::mutex::scoped_lock lock(mutex);
-	cond.notify_all();
-}
-
-bool RctRosBridge::run() {
-
-	RSCINFO(logger, "start running");
-
-	// run until interrupted
-	while (!interrupted && ros::ok()) {
-		boost::mutex::scoped_lock lock(mutex);
-		// wait for notification
-		RSCTRACE(logger, "wait");
-		cond.wait(lock);
-		RSCTRACE(logger, "notified");
-		if (bridge) {
-			while (rsbHandler->hasTransforms()) {
-				RSCDEBUG(logger, "rsb handler has transforms");
-				TransformWrapper t = rsbHandler->nextTransform();
-				if (t.getAuthority() != commRsb->getAuthorityName()) {
-					TransformType type = STATIC;
-					if (!t.isStatic) {
-						type = DYNAMIC;
-						RSCDEBUG(logger, "publish dynamic transform " << t);
-					} else {
-						RSCDEBUG(logger, "publish static transform " << t);
-					}
-					t.setAuthority(string("rct:") + t.getAuthority());
-					try {
-						commRos->sendTransform(t, type);
-					} catch (std::exception& e) {
-						RSCTRACE(logger, "Error sending transform. Reason: " << e.what());
-					}
-				} else {
-					RSCTRACE(logger,
-							"skip bridging of transform from rsb to ros because own authority: " << t.getAuthority());
-				}
-			}
-			while (rosHandler->hasTransforms()) {
-				RSCDEBUG(logger, "ros handler has transforms");
-				TransformWrapper t = rosHandler->nextTransform();
-				if (t.getAuthority() != commRos->getAuthorityName()) {
-					TransformType type = STATIC;
-					if (!t.isStatic) {
-						type = DYNAMIC;
-					}
-					t.setAuthority(string("ros:") + t.getAuthority());
-					try {
-						commRsb->sendTransform(t, type);
-					} catch (std::exception& e) {
-						RSCTRACE(logger, "Error sending transform. Reason: " << e.what());
-					}
-				} else {
-					RSCTRACE(logger,
-							"skip bridging of transform from ros to rsb because own authority: " << t.getAuthority());
-				}
-			}
-		}
-		RSCTRACE(logger, "loop done");
-	}
-	RSCWARN(logger, "interrupted");
-	RSCINFO(logger, "shutdown");
-	RSCTRACE(logger, "shutdown rsb communicator");
-	commRsb->shutdown();
-	RSCTRACE(logger, "shutdown ros communicator");
-	commRos->shutdown();
-
-	if (!ros::ok()) {
-		RSCWARN(logger, "Shutdown request received from ROS");
-		cerr << "Shutdown request received from ROS" << endl;
-		return 1;
-	}
-	RSCINFO(logger, "done");
-	return 0;
-}
-void RctRosBridge::interrupt() {
-	interrupted = true;
-	notify();
-}
-
-RctRosBridge::~RctRosBridge() {
-}
-
-void Handler::newTransformAvailable(const Transform& transform, bool isStatic) {
-	RSCTRACE(logger, "newTransformAvailable()");
-	{
-		boost::mutex::scoped_lock lock(mutexHandler);
-		TransformWrapper w(transform, isStatic);
-		transforms.push_back(w);
-	}
-	parent->notify();
-}
-bool Handler::hasTransforms() {
-	boost::mutex::scoped_lock lock(mutexHandler);
-	return !transforms.empty();
-}
-
-TransformWrapper Handler::nextTransform() {
-	if (!hasTransforms()) {
-		throw std::range_error("no transforms available");
-	}
-	boost::mutex::scoped_lock lock(mutexHandler);
-	TransformWrapper ret = *transforms.begin();
-	transforms.erase(transforms.begin());
-	return ret;
-}
-
-} /* namespace rct */
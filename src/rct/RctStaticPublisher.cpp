@@ -7,12 +7,19 @@
 
 #include "parsers/ParserINI.h"
 #include "parsers/ParserXML.h"
+#include "parsers/WriterXML.h"
+#include "graph/FrameGraph.h"
+#include "sync/StaticSyncClient.h"
+#include "sync/StaticSyncServer.h"
+#include "util/RsbTransport.h"
+#include "util/StartupProfiler.h"
 #include <rct/rct.h>
 
 #include <boost/program_options.hpp>
 
 #include <boost/filesystem.hpp>
 #include <boost/algorithm/string/predicate.hpp>
+#include <rsb/Factory.h>
 #include <rsc/logging/Logger.h>
 #include <iostream>
 #include <csignal>
@@ -31,12 +38,24 @@ void signalHandler(int signum) {
 }
 
 int main(int argc, char **argv) {
+	StartupProfiler profiler;
 	options_description desc("Allowed options");
 	variables_map vm;
 
 	desc.add_options()("help,h", "produce help message") // help
 	("config,c", value<string>(), "a single config file") // config file
 	("name,n", value<string>(), "name for this instance") // config file
+	("precompose", "additionally publish precomposed root-to-leaf transforms") // precompose
+	("precompose-prefix", value<string>()->default_value("precomposed/"),
+			"frame name prefix of the precomposed leaf frames") // precompose prefix
+	("precompose-sidecar", value<string>(),
+			"write the precomposed transforms to this xml file") // precompose sidecar
+	("sync", "serve the static transforms to late joining receivers") // sync
+	("sync-scope", value<string>()->default_value(StaticSyncServer::DEFAULT_SCOPE),
+			"scope of the static sync service") // sync scope
+	("sync-inprocess", "serve the static sync service on the in-process transport only") // sync inprocess
+	("sync-selftest", "fetch the served table once through the sync service and exit") // sync selftest
+	("startup-profile", "print the time spent in each startup phase once started") // startup profile
 	("debug", "debug mode") //debug
 	("trace", "trace mode") //trace
 	("info", "info mode");
@@ -68,7 +87,7 @@ int main(int argc, char **argv) {
 	} else if (vm.count("info")) {
 		Logger::getLogger("rct")->setLevel(Logger::LEVEL_INFO);
 	}
-
+	profiler.mark("options");
 
 	string configFile = vm["config"].as<string>();
 	LoggerPtr logger = Logger::getLogger("rct.RctStaticPublisher");
@@ -83,23 +102,77 @@ int main(int argc, char **argv) {
 	try {
 
 		TransformPublisher::Ptr publisher = getTransformerFactory().createTransformPublisher(name);
+		profiler.mark("create publisher");
 
 		RSCDEBUG(logger, "reading config file: " << configFile)
 		ParserResultTransforms result;
+		Parser::Ptr parser;
 		vector<Parser::Ptr>::iterator it;
 		for (it = parsers.begin(); it != parsers.end(); ++it) {
-			Parser::Ptr p = *it;
-			if (p->canParse(configFile)){
-				result =p->parseStaticTransforms(configFile);
+			if ((*it)->canParse(configFile)){
+				parser = *it;
 				break;
 			}
 		}
+		profiler.mark("config canParse");
+		if (parser) {
+			result = parser->parseStaticTransforms(configFile);
+		}
+		profiler.mark("config parse");
+
+		vector<Transform> shortcuts;
+		if (vm.count("precompose") || vm.count("precompose-sidecar")) {
+			// fails on cycles and frames with multiple parents
+			FrameGraph graph;
+			graph.addTransforms(result.transforms);
+			shortcuts = graph.shortcuts(vm["precompose-prefix"].as<string>());
+			RSCINFO(logger, "precomposed " << shortcuts.size() << " root-to-leaf transforms");
+
+			if (vm.count("precompose-sidecar")) {
+				ParserResultTransforms sidecar;
+				sidecar.config = result.config;
+				sidecar.transforms = shortcuts;
+				WriterXML().writeStaticTransforms(vm["precompose-sidecar"].as<string>(), sidecar);
+			}
+			profiler.mark("precompose");
+		}
+
+		StaticSyncServer::Ptr syncServer;
+		if (vm.count("sync") || vm.count("sync-selftest")) {
+			rsb::ParticipantConfig syncConfig = rsb::getFactory().getDefaultParticipantConfig();
+			if (vm.count("sync-inprocess")) {
+				syncConfig = inprocessParticipantConfig();
+			}
+			rsb::Scope syncScope(vm["sync-scope"].as<string>());
+			vector<Transform> table = result.transforms;
+			if (vm.count("precompose")) {
+				table.insert(table.end(), shortcuts.begin(), shortcuts.end());
+			}
+			syncServer = StaticSyncServer::Ptr(new StaticSyncServer(syncScope, syncConfig));
+			syncServer->setTransforms(table);
+			profiler.mark("sync server");
+
+			if (vm.count("sync-selftest")) {
+				StaticSyncClient client(syncScope, syncConfig);
+				vector<Transform> fetched = client.fetch();
+				cout << "fetched " << fetched.size() << " of " << table.size()
+						<< " static transforms" << endl;
+				return fetched.size() == table.size() ? 0 : 1;
+			}
+		}
 
 		if (result.transforms.empty()) {
 			RSCERROR(logger, "no transforms to publish")
 		} else {
 			cout << "successfully started" << endl;
 			publisher->sendTransform(result.transforms, rct::STATIC);
+			if (vm.count("precompose") && !shortcuts.empty()) {
+				publisher->sendTransform(shortcuts, rct::STATIC);
+			}
+		}
+		profiler.mark("send transforms");
+		if (vm.count("startup-profile")) {
+			profiler.report(cerr);
 		}
 
 		// run until interrupted
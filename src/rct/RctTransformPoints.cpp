@@ -0,0 +1,399 @@
+/*
+ * RctTransformPoints.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: lziegler
+ */
+#include <rct/rctConfig.h>
+#include <rct/TransformerFactory.h>
+#include "points/PointKernels.h"
+#include "util/Clock.h"
+#include "util/StartupProfiler.h"
+#include <boost/program_options.hpp>
+#include <boost/thread.hpp>
+#include <rsc/logging/Logger.h>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <stdexcept>
+
+using namespace boost::program_options;
+using namespace std;
+using namespace rct;
+using namespace rsc::logging;
+
+// a time of zero requests the latest available transform
+const boost::posix_time::ptime LATEST = boost::posix_time::from_time_t(0);
+
+class PointOptions {
+public:
+	PointOptions() :
+			timestamps(false), time(LATEST), threads(1), timeout(2.0), quiet(false), startupProfile(
+					false) {
+	}
+	string frameFrom;
+	string frameTo;
+	string input;
+	string output;
+	string format;
+	string outputFormat;
+	bool timestamps;
+	boost::posix_time::ptime time;
+	unsigned int threads;
+	double timeout;
+	bool quiet;
+	bool startupProfile;
+};
+
+void printHelp(int argc, char **argv, options_description desc) {
+	cout << "Usage:\n  " << argv[0] << " [options] from_frame to_frame\n" << endl;
+	cout << desc << endl;
+	cout << "This will transform points given in from_frame into to_frame." << endl;
+	cout << "Formats: csv (x,y,z per line), float32 and float64 (raw" << endl;
+	cout << "interleaved x,y,z). With --timestamps every point is preceded" << endl;
+	cout << "by its time in seconds since the epoch and the transform is" << endl;
+	cout << "looked up once per distinct time. Binary timestamped input" << endl;
+	cout << "must be float64." << endl;
+}
+
+boost::posix_time::ptime fromSeconds(double seconds) {
+	return boost::posix_time::from_time_t(0)
+			+ boost::posix_time::microseconds(boost::int64_t(seconds * 1000000.0));
+}
+
+template<class Scalar>
+void readCsv(istream &in, bool timestamps, vector<Scalar> &points, vector<double> &times) {
+	string line;
+	unsigned int lineNumber = 0;
+	unsigned int columns = timestamps ? 4 : 3;
+	double values[4];
+	while (getline(in, line)) {
+		lineNumber++;
+		if (line.empty() || line[0] == '#') {
+			continue;
+		}
+		const char* p = line.c_str();
+		for (unsigned int i = 0; i < columns; ++i) {
+			while (*p == ',' || *p == ' ' || *p == '\t' || *p == ';') {
+				p++;
+			}
+			char* end;
+			values[i] = strtod(p, &end);
+			if (end == p) {
+				stringstream ss;
+				ss << "line " << lineNumber << ": expected " << columns << " numbers";
+				throw runtime_error(ss.str());
+			}
+			p = end;
+		}
+		unsigned int first = 0;
+		if (timestamps) {
+			times.push_back(values[0]);
+			first = 1;
+		}
+		points.push_back(values[first]);
+		points.push_back(values[first + 1]);
+		points.push_back(values[first + 2]);
+	}
+}
+
+void readAll(istream &in, vector<char> &data) {
+	const size_t chunk = 1 << 20;
+	size_t size = 0;
+	streampos begin = in.tellg();
+	if (begin != streampos(-1)) {
+		in.seekg(0, ios::end);
+		streampos end = in.tellg();
+		in.seekg(begin);
+		if (end > begin) {
+			data.reserve(size_t(end - begin) + chunk);
+		}
+	}
+	while (in) {
+		data.resize(size + chunk);
+		in.read(&data[size], chunk);
+		size += in.gcount();
+	}
+	data.resize(size);
+}
+
+template<class Scalar>
+void readBinary(istream &in, bool timestamps, vector<Scalar> &points, vector<double> &times) {
+	vector<char> data;
+	readAll(in, data);
+	size_t stride = timestamps ? 4 : 3;
+	size_t record = stride * sizeof(Scalar);
+	if (data.size() % record != 0) {
+		throw runtime_error("binary input size is not a multiple of the record size");
+	}
+	size_t count = data.size() / record;
+	if (!timestamps) {
+		points.resize(3 * count);
+		if (count > 0) {
+			memcpy(&points[0], &data[0], data.size());
+		}
+		return;
+	}
+	points.resize(3 * count);
+	times.resize(count);
+	if (count == 0) {
+		return;
+	}
+	const Scalar* values = reinterpret_cast<const Scalar*>(&data[0]);
+	for (size_t i = 0; i < count; ++i) {
+		times[i] = values[4 * i];
+		points[3 * i] = values[4 * i + 1];
+		points[3 * i + 1] = values[4 * i + 2];
+		points[3 * i + 2] = values[4 * i + 3];
+	}
+}
+
+template<class Scalar>
+void writeCsv(ostream &out, const vector<Scalar> &points, const vector<double> &times) {
+	out << setprecision(numeric_limits<Scalar>::digits10 + 2);
+	size_t count = points.size() / 3;
+	for (size_t i = 0; i < count; ++i) {
+		if (!times.empty()) {
+			out << setprecision(17) << times[i] << ","
+					<< setprecision(numeric_limits<Scalar>::digits10 + 2);
+		}
+		out << points[3 * i] << "," << points[3 * i + 1] << "," << points[3 * i + 2] << "\n";
+	}
+}
+
+template<class Scalar>
+void writeBinary(ostream &out, const vector<Scalar> &points, const vector<double> &times) {
+	if (points.empty()) {
+		return;
+	}
+	size_t count = points.size() / 3;
+	if (times.empty()) {
+		out.write(reinterpret_cast<const char*>(&points[0]), points.size() * sizeof(Scalar));
+		return;
+	}
+	for (size_t i = 0; i < count; ++i) {
+		Scalar record[4] = { Scalar(times[i]), points[3 * i], points[3 * i + 1], points[3 * i + 2] };
+		out.write(reinterpret_cast<const char*>(record), sizeof(record));
+	}
+}
+
+void report(const PointOptions &options, const string &phase, boost::uint64_t nanos, size_t count) {
+	if (options.quiet) {
+		return;
+	}
+	double seconds = nanos / 1000000000.0;
+	cerr << left << setw(10) << phase << right << fixed << setprecision(3) << setw(12)
+			<< seconds * 1000.0 << " ms" << setprecision(1) << setw(14)
+			<< (seconds > 0.0 ? count / seconds / 1000000.0 : 0.0) << " Mpoints/s" << endl;
+}
+
+template<class Scalar>
+int process(const PointOptions &options, StartupProfiler &profiler) {
+	vector<Scalar> points;
+	vector<double> times;
+
+	// start joining the middleware while the input is read
+	TransformReceiver::Ptr receiver = getTransformerFactory().createTransformReceiver();
+	profiler.mark("create receiver");
+	if (options.startupProfile) {
+		profiler.report(cerr);
+	}
+
+	boost::uint64_t start = monotonicNanos();
+	boost::uint64_t t0 = start;
+	{
+		ifstream file;
+		istream* in = &cin;
+		if (options.input != "-") {
+			file.open(options.input.c_str(), ios::binary);
+			if (!file.is_open()) {
+				cerr << "ERROR: cannot read " << options.input << endl;
+				return 1;
+			}
+			in = &file;
+		}
+		if (options.format == "csv") {
+			readCsv(*in, options.timestamps, points, times);
+		} else {
+			readBinary(*in, options.timestamps, points, times);
+		}
+	}
+	size_t count = points.size() / 3;
+	report(options, "read", monotonicNanos() - t0, count);
+
+	// one lookup per distinct time, issued at once; consecutive points with the
+	// same time form one segment
+	t0 = monotonicNanos();
+	vector<TransformReceiver::FuturePtr> futures;
+	vector<PointJob> jobs;
+	if (options.timestamps) {
+		map<double, size_t> lookups;
+		size_t segmentStart = 0;
+		for (size_t i = 1; i <= count; ++i) {
+			if (i < count && times[i] == times[segmentStart]) {
+				continue;
+			}
+			double time = times[segmentStart];
+			map<double, size_t>::iterator it = lookups.find(time);
+			if (it == lookups.end()) {
+				it = lookups.insert(make_pair(time, futures.size())).first;
+				futures.push_back(
+						receiver->requestTransform(options.frameTo, options.frameFrom,
+								fromSeconds(time)));
+			}
+			appendPointJobs(jobs, segmentStart, i - segmentStart, it->second);
+			segmentStart = i;
+		}
+	} else {
+		futures.push_back(receiver->requestTransform(options.frameTo, options.frameFrom, options.time));
+		appendPointJobs(jobs, 0, count, 0);
+	}
+
+	typename PointTransforms<Scalar>::Vector transforms;
+	vector<TransformReceiver::FuturePtr>::iterator fIt;
+	for (fIt = futures.begin(); fIt != futures.end(); ++fIt) {
+		rct::Transform t = (*fIt)->get(options.timeout);
+		transforms.push_back(t.getTransform().template cast<Scalar>());
+	}
+	if (!options.quiet) {
+		cerr << left << setw(10) << "lookup" << right << fixed << setprecision(3) << setw(12)
+				<< nanosToMillis(monotonicNanos() - t0) << " ms" << setw(14) << futures.size()
+				<< " transforms" << endl;
+	}
+
+	t0 = monotonicNanos();
+	if (count > 0) {
+		transformPointsParallel<Scalar>(transforms, jobs, &points[0], &points[0], options.threads);
+	}
+	report(options, "transform", monotonicNanos() - t0, count);
+
+	t0 = monotonicNanos();
+	{
+		ofstream file;
+		ostream* out = &cout;
+		if (options.output != "-") {
+			file.open(options.output.c_str(), ios::binary);
+			if (!file.is_open()) {
+				cerr << "ERROR: cannot write to " << options.output << endl;
+				return 1;
+			}
+			out = &file;
+		}
+		if (options.outputFormat == "csv") {
+			writeCsv(*out, points, times);
+		} else {
+			writeBinary(*out, points, times);
+		}
+		out->flush();
+	}
+	report(options, "write", monotonicNanos() - t0, count);
+	report(options, "total", monotonicNanos() - start, count);
+	return 0;
+}
+
+int main(int argc, char **argv) {
+	StartupProfiler profiler;
+	boost::program_options::positional_options_description p0;
+	p0.add("frames", -1);
+
+	options_description desc("Allowed options");
+	variables_map vm;
+
+	desc.add_options()("help,h", "produce help message") // help
+	("debug", "debug mode") //debug
+	("trace", "trace mode") //trace
+	("input,i", value<string>()->default_value("-"), "input file ('-' for stdin)") //input
+	("output,o", value<string>()->default_value("-"), "output file ('-' for stdout)") //output
+	("format", value<string>()->default_value("csv"), "input format: csv, float32 or float64") //format
+	("output-format", value<string>(), "output format (default: input format)") //output format
+	("timestamps", "every point starts with its time, look up one transform per time") //timestamps
+	("time", value<double>(), "time of the single lookup in seconds since the epoch (default: latest)") //time
+	("threads,j", value<unsigned int>(), "worker threads (default: number of cores)") //threads
+	("timeout", value<double>()->default_value(2.0), "time waiting for each transform (seconds)") //timeout
+	("quiet,q", "do not print the throughput report") //quiet
+	("startup-profile", "print the time spent in each startup phase once started") // startup profile
+	("info", "info mode");
+
+	options_description hidden("Hidden options");
+	hidden.add_options()("frames", value<vector<string> >(), "frames");
+
+	options_description all;
+	all.add(desc).add(hidden);
+	store(command_line_parser(argc, argv).options(all).positional(p0).run(), vm);
+	notify(vm);
+
+	if (vm.count("help")) {
+		printHelp(argc, argv, desc);
+		return 0;
+	}
+
+	Logger::getLogger("")->setLevel(Logger::LEVEL_WARN);
+	if (vm.count("debug")) {
+		Logger::getLogger("rct")->setLevel(Logger::LEVEL_DEBUG);
+	} else if (vm.count("trace")) {
+		Logger::getLogger("rct")->setLevel(Logger::LEVEL_TRACE);
+	} else if (vm.count("info")) {
+		Logger::getLogger("rct")->setLevel(Logger::LEVEL_INFO);
+	}
+
+	if (!vm.count("frames") || vm["frames"].as<vector<string> >().size() != 2) {
+		printHelp(argc, argv, desc);
+		return -1;
+	}
+
+	PointOptions options;
+	vector<string> frames = vm["frames"].as<vector<string> >();
+	options.frameFrom = frames[0];
+	options.frameTo = frames[1];
+	options.input = vm["input"].as<string>();
+	options.output = vm["output"].as<string>();
+	options.format = vm["format"].as<string>();
+	options.outputFormat = options.format;
+	if (vm.count("output-format")) {
+		options.outputFormat = vm["output-format"].as<string>();
+	}
+	options.timestamps = vm.count("timestamps");
+	if (vm.count("time")) {
+		options.time = fromSeconds(vm["time"].as<double>());
+	}
+	options.threads = max(1u, boost::thread::hardware_concurrency());
+	if (vm.count("threads")) {
+		options.threads = max(1u, vm["threads"].as<unsigned int>());
+	}
+	options.timeout = vm["timeout"].as<double>();
+	options.quiet = vm.count("quiet");
+	options.startupProfile = vm.count("startup-profile");
+
+	string formats[] = { options.format, options.outputFormat };
+	for (unsigned int i = 0; i < 2; ++i) {
+		if (formats[i] != "csv" && formats[i] != "float32" && formats[i] != "float64") {
+			cerr << "ERROR: unknown format " << formats[i] << endl;
+			return -1;
+		}
+	}
+	if (options.format != "csv" && options.outputFormat != "csv"
+			&& options.format != options.outputFormat) {
+		cerr << "ERROR: binary input and output must have the same format" << endl;
+		return -1;
+	}
+	if (options.timestamps && (options.format == "float32" || options.outputFormat == "float32")) {
+		cerr << "ERROR: timestamped binary points must be float64" << endl;
+		return -1;
+	}
+
+	profiler.mark("options");
+	try {
+		if (options.format == "float32" || options.outputFormat == "float32") {
+			return process<float>(options, profiler);
+		}
+		return process<double>(options, profiler);
+	} catch (std::exception &e) {
+		cerr << "ERROR: " << e.what() << endl;
+		return 1;
+	}
+}
@@ -15,6 +15,16 @@
 #include <boost/progress.hpp>
 #include <rsc/logging/Logger.h>
 #include "rct-tools-config.h"
+#ifdef RCT_VIEW_HEADLESS
+#undef POPPLERQT4_FOUND
+#undef POPPLERQT5_FOUND
+#undef QT5WIDGETS_FOUND
+#endif
+#include "graph/GraphExport.h"
+#include "monitor/EdgeMonitor.h"
+#include "shm/TransformSnapshot.h"
+#include "util/Clock.h"
+#include "util/StartupProfiler.h"
 #ifdef POPPLERQT4_FOUND
 #include <poppler-qt4.h>
 #endif
@@ -24,6 +34,11 @@
 #include <QApplication>
 #include "viewer/imageviewer.h"
 #endif
+#ifdef QT5WIDGETS_FOUND
+#include <QtCore>
+#include <QApplication>
+#include "viewer/graphviewer.h"
+#endif
 #include <fstream>
 #include <iostream>
 #include <stdio.h>
@@ -39,48 +54,94 @@ void printHelp(int argc, char **argv, options_description desc) {
 	cout << "This will print all transforms as a graph." << endl;
 }
 
-int main(int argc, char **argv) {
-
-	options_description desc("Allowed options");
-	variables_map vm;
-
-	desc.add_options()("help,h", "produce help message") // help
-	("debug", "debug mode") //debug
-	("trace", "trace mode") //trace
-	("duration", value<double>(), "time waiting for transforms (seconds)") // duration
-	("info", "info mode");
+void setupApplication() {
+#if defined(POPPLERQT5_FOUND) || defined(QT5WIDGETS_FOUND)
+	QCoreApplication::setOrganizationName("Bielefeld University, CITEC, Central Lab Facilities");
+	QCoreApplication::setOrganizationDomain("clf.cit-ec.uni-bielefeld.de");
+	QCoreApplication::setApplicationName("rct-view");
+#endif
+}
 
-	store(command_line_parser(argc, argv).options(desc).run(), vm);
-	notify(vm);
+int exportGraph(const vector<rct::EdgeInfo> &edges, const variables_map &vm) {
+	rct::GraphExport::Format format;
+	try {
+		format = rct::GraphExport::parseFormat(vm["export"].as<string>());
+	} catch (std::exception &e) {
+		cerr << "Error:\n  " << e.what() << "\n" << endl;
+		return 1;
+	}
+	if (edges.empty()) {
+		cerr << "no transforms found" << endl;
+		return 1;
+	}
 
-	if (vm.count("help")) {
-		cout << 0 << endl;
-		printHelp(argc, argv, desc);
+	if (!vm.count("output")) {
+		rct::GraphExport::write(cout, edges, format);
 		return 0;
 	}
-
-	Logger::getLogger("")->setLevel(Logger::LEVEL_WARN);
-	if (vm.count("debug")) {
-		Logger::getLogger("rct")->setLevel(Logger::LEVEL_DEBUG);
-	} else if (vm.count("trace")) {
-		Logger::getLogger("rct")->setLevel(Logger::LEVEL_TRACE);
-	} else if (vm.count("info")) {
-		Logger::getLogger("rct")->setLevel(Logger::LEVEL_INFO);
+	string file = vm["output"].as<string>();
+	ofstream out(file.c_str());
+	if (!out.is_open()) {
+		cerr << "Error:\n  cannot write to " << file << "\n" << endl;
+		return 1;
 	}
+	rct::GraphExport::write(out, edges, format);
+	return 0;
+}
 
-	double seconds = 5.0;
-	if (vm.count("duration")) {
-		seconds = vm["duration"].as<double>();
+/**
+ * Edges from the shared memory snapshot of rct-daemon. Rates and delays are
+ * not part of the snapshot and stay zero.
+ */
+vector<rct::EdgeInfo> readSnapshot(const string &name) {
+	rct::TransformSnapshotReader reader(name);
+	vector<rct::SnapshotEdge> snapshot = reader.read();
+	vector<rct::EdgeInfo> edges;
+	vector<rct::SnapshotEdge>::iterator it;
+	for (it = snapshot.begin(); it != snapshot.end(); ++it) {
+		rct::EdgeInfo edge;
+		edge.parent = it->transform.getFrameParent();
+		edge.child = it->transform.getFrameChild();
+		edge.authority = it->transform.getAuthority();
+		edge.isStatic = it->isStatic;
+		edge.updates = it->updates;
+		edge.lastStamp = it->transform.getTime();
+		edge.lastReceipt = it->lastReceipt;
+		edges.push_back(edge);
 	}
+	return edges;
+}
 
-	rct::TransformReceiver::Ptr receiver = rct::getTransformerFactory().createTransformReceiver();
+#ifdef POPPLERQT5_FOUND
+/**
+ * Renders parts of a PDF page with poppler. Owns document and page.
+ */
+class PopplerTileRenderer: public TileRenderer {
+public:
+	PopplerTileRenderer(Poppler::Document *document, Poppler::Page *page) :
+			document(document), page(page) {
+		document->setRenderHint(Poppler::Document::Antialiasing);
+		document->setRenderHint(Poppler::Document::TextAntialiasing);
+	}
+	virtual ~PopplerTileRenderer() {
+		delete page;
+		delete document;
+	}
+	QSizeF pageSize() const {
+		return page->pageSizeF();
+	}
+	QImage render(double dpi, const QRect &rect) const {
+		return page->renderToImage(dpi, dpi, rect.x(), rect.y(), rect.width(), rect.height());
+	}
 
-	cout << "collecting transforms for " << seconds << " sec" << endl;
-	usleep(seconds * 1000000.0);
-	cout << "done" << endl;
+private:
+	Poppler::Document *document;
+	Poppler::Page *page;
+};
+#endif
 
+int renderGraphviz(int argc, char **argv, rct::TransformReceiver::Ptr receiver) {
 	string dotStr = receiver->getCore()->allFramesAsDot();
-
 	if (dotStr.empty()) {
 		cerr << "no transforms found" << endl;
 		return 1;
@@ -138,26 +199,20 @@ int main(int argc, char **argv) {
 	Poppler::Page* pdfPage = document->page(0);  // Document starts at page 0
 	if (pdfPage == 0) {
 		cerr << "can not load " << tmpTgtStr << endl;
+		delete document;
 		return 1;
 	}
-	// Generate a QImage of the rendered page
-	QImage image = pdfPage->renderToImage(300,300);
-	if (image.isNull()) {
-		cerr << "can not render " << tmpTgtStr << endl;
-	  return 1;
-	}
 
 	QApplication app(argc, argv);
-	QCoreApplication::setOrganizationName("Bielefeld University, CITEC, Central Lab Facilities");
-	QCoreApplication::setOrganizationDomain("clf.cit-ec.uni-bielefeld.de");
-	QCoreApplication::setApplicationName("rct-view");
+	setupApplication();
 	ImageViewer imageViewer;
-	imageViewer.showImage(image);
+	// the viewer renders the visible tiles of the page on demand
+	if (!imageViewer.showPage(new PopplerTileRenderer(document, pdfPage))) {
+		cerr << "can not render " << tmpTgtStr << endl;
+		return 1;
+	}
 	imageViewer.show();
 	return app.exec();
-
-	// after the usage, the page must be deleted
-	delete pdfPage;
 #else
 		boost::filesystem::copy_file(tmpTgtStr,"frames.pdf",boost::filesystem::copy_option::overwrite_if_exists);
 		cout << "frames.pdf generated" << endl;
@@ -170,3 +225,143 @@ int main(int argc, char **argv) {
 	return 0;
 }
 
+int main(int argc, char **argv) {
+	rct::StartupProfiler profiler;
+
+	options_description desc("Allowed options");
+	variables_map vm;
+
+	desc.add_options()("help,h", "produce help message") // help
+	("debug", "debug mode") //debug
+	("trace", "trace mode") //trace
+	("duration", value<double>(), "maximum time waiting for transforms (seconds)") // duration
+	("quiet-period", value<double>()->default_value(0.5),
+			"stop waiting once no new frames arrived for this time (seconds)") // quiet period
+	("graphviz", "render the graph with graphviz instead of the built-in layout") // graphviz
+	("export", value<string>(), "write the graph as dot, svg or json instead of showing it") // export
+	("output,o", value<string>(), "file to export to (default: standard output)") // output
+	("shm", value<string>()->implicit_value(rct::TransformSnapshotWriter::DEFAULT_NAME),
+			"read the graph from the shared memory segment of rct-daemon instead of collecting") // shm
+	("live", "keep the graph open and update it as transforms arrive") // live
+	("refresh", value<int>()->default_value(500), "refresh interval of the live graph (milliseconds)") // refresh
+	("stale-factor", value<double>()->default_value(5.0),
+			"live graph marks dynamic edges stale after this many mean publish intervals") // stale factor
+	("startup-profile", "print the time spent in each startup phase before showing the graph") // startup profile
+	("info", "info mode");
+
+	store(command_line_parser(argc, argv).options(desc).run(), vm);
+	notify(vm);
+
+	if (vm.count("help")) {
+		cout << 0 << endl;
+		printHelp(argc, argv, desc);
+		return 0;
+	}
+
+	Logger::getLogger("")->setLevel(Logger::LEVEL_WARN);
+	if (vm.count("debug")) {
+		Logger::getLogger("rct")->setLevel(Logger::LEVEL_DEBUG);
+	} else if (vm.count("trace")) {
+		Logger::getLogger("rct")->setLevel(Logger::LEVEL_TRACE);
+	} else if (vm.count("info")) {
+		Logger::getLogger("rct")->setLevel(Logger::LEVEL_INFO);
+	}
+
+	profiler.mark("options");
+
+	if (vm.count("shm")) {
+		vector<rct::EdgeInfo> edges;
+		try {
+			edges = readSnapshot(vm["shm"].as<string>());
+		} catch (std::exception &e) {
+			cerr << "Error:\n  " << e.what() << "\n" << endl;
+			return 1;
+		}
+		profiler.mark("read snapshot");
+		if (vm.count("startup-profile")) {
+			profiler.report(cerr);
+		}
+		if (vm.count("export")) {
+			return exportGraph(edges, vm);
+		}
+#ifdef QT5WIDGETS_FOUND
+		if (edges.empty()) {
+			cerr << "no transforms found" << endl;
+			return 1;
+		}
+		QApplication app(argc, argv);
+		setupApplication();
+		GraphViewer graphViewer;
+		graphViewer.updateGraph(edges);
+		graphViewer.show();
+		return app.exec();
+#else
+		cerr << "showing the snapshot requires Qt5, use --export" << endl;
+		return 1;
+#endif
+	}
+
+	double seconds = 5.0;
+	if (vm.count("duration")) {
+		seconds = vm["duration"].as<double>();
+	}
+
+	rct::EdgeMonitor::Ptr monitor(new rct::EdgeMonitor());
+	rct::TransformReceiver::Ptr receiver = rct::getTransformerFactory().createTransformReceiver(
+			monitor);
+	profiler.mark("create receiver");
+
+	if (vm.count("live")) {
+#ifdef QT5WIDGETS_FOUND
+		QApplication app(argc, argv);
+		setupApplication();
+		GraphViewer graphViewer;
+		graphViewer.setStaleFactor(vm["stale-factor"].as<double>());
+		graphViewer.follow(monitor, vm["refresh"].as<int>());
+		graphViewer.show();
+		profiler.mark("create window");
+		if (vm.count("startup-profile")) {
+			profiler.report(cerr);
+		}
+		return app.exec();
+#else
+		cerr << "live mode requires Qt5" << endl;
+		return 1;
+#endif
+	}
+
+	// keep standard output clean when the graph is exported to it
+	ostream &status = vm.count("export") ? cerr : cout;
+	status << "collecting transforms for up to " << seconds << " sec" << endl;
+	boost::uint64_t start = rct::monotonicNanos();
+	monitor->waitForStableStructure(vm["quiet-period"].as<double>(), seconds);
+	status << "done after " << rct::nanosToMillis(rct::monotonicNanos() - start) / 1000.0 << " sec"
+			<< endl;
+	profiler.mark("collect transforms");
+	if (vm.count("startup-profile")) {
+		profiler.report(cerr);
+	}
+
+	if (vm.count("export")) {
+		return exportGraph(monitor->snapshot(), vm);
+	}
+
+#ifdef QT5WIDGETS_FOUND
+	if (!vm.count("graphviz")) {
+		vector<rct::EdgeInfo> edges = monitor->snapshot();
+		if (edges.empty()) {
+			cerr << "no transforms found" << endl;
+			return 1;
+		}
+
+		QApplication app(argc, argv);
+		setupApplication();
+		GraphViewer graphViewer;
+		graphViewer.updateGraph(edges);
+		graphViewer.show();
+		return app.exec();
+	}
+#endif
+
+	return renderGraphviz(argc, argv, receiver);
+}
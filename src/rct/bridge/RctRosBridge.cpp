@@ -0,0 +1,241 @@
+/*
+ * RctRosBridge.cpp
+ *
+ *  Created on: Dec 16, 2014
+ *      Author: leon
+ */
+
+#include "RctRosBridge.h"
+#include "../util/AllocationCounter.h"
+#include "../util/Probes.h"
+#include <rct/impl/TransformCommRsb.h>
+#include <rct/impl/TransformCommRos.h>
+
+#include <iostream>
+#include <stdexcept>
+
+using namespace std;
+
+namespace rct {
+
+rsc::logging::LoggerPtr RctRosBridge::logger = rsc::logging::Logger::getLogger("rct.RctRosBridge");
+
+RctRosBridge::RctRosBridge(const string &name, bool rosLegacyMode, long rosLegacyIntervalMSec) :
+		interrupted(false), ownsRsb(true), rctAuthorities("rct:"), rosAuthorities("ros:") {
+
+	rsbHandler = Handler::Ptr(new Handler(this, "Rsb"));
+
+	TransformerConfig configRsb;
+	configRsb.setCommType(TransformerConfig::RSB);
+	commRsb = TransformCommRsb::Ptr(new TransformCommRsb(name, rsbHandler));
+	commRsb->init(configRsb);
+	rsbAuthority = commRsb->getAuthorityName();
+
+	initRos(name, rosLegacyMode, rosLegacyIntervalMSec);
+}
+
+RctRosBridge::RctRosBridge(const string &name, TransformCommunicator::Ptr sharedRsb,
+		bool rosLegacyMode, long rosLegacyIntervalMSec) :
+		commRsb(sharedRsb), interrupted(false), ownsRsb(false), rctAuthorities("rct:"), rosAuthorities(
+				"ros:") {
+
+	rsbHandler = Handler::Ptr(new Handler(this, "Rsb"));
+	rsbAuthority = commRsb->getAuthorityName();
+
+	initRos(name, rosLegacyMode, rosLegacyIntervalMSec);
+}
+
+TransformListener::Ptr RctRosBridge::getRsbListener() const {
+	return rsbHandler;
+}
+
+void RctRosBridge::initRos(const string &name, bool rosLegacyMode, long rosLegacyIntervalMSec) {
+	rosHandler = Handler::Ptr(new Handler(this, "Ros"));
+
+	TransformerConfig configRos;
+	configRos.setCommType(TransformerConfig::ROS);
+	commRos = TransformCommRos::Ptr(new TransformCommRos(name, configRos.getCacheTime(), rosHandler, rosLegacyMode, rosLegacyIntervalMSec));
+	commRos->init(configRos);
+	rosAuthority = commRos->getAuthorityName();
+}
+
+void RctRosBridge::setStaticStore(StaticTransformStore::Ptr store) {
+	staticStore = store;
+}
+
+void RctRosBridge::setWatchdog(StalenessWatchdog::Ptr watchdog) {
+	rsbHandler->setWatchdog(watchdog, rsbAuthority);
+	rosHandler->setWatchdog(watchdog, rosAuthority);
+}
+
+void RctRosBridge::republishStatics() {
+	if (!staticStore) {
+		return;
+	}
+	// restored transforms already carry the prefixed authority
+	vector<Transform> toRos = staticStore->restored(StaticTransformStore::TO_ROS);
+	vector<Transform> toRsb = staticStore->restored(StaticTransformStore::TO_RSB);
+	try {
+		if (!toRos.empty()) {
+			commRos->sendTransform(toRos, STATIC);
+		}
+		if (!toRsb.empty()) {
+			commRsb->sendTransform(toRsb, STATIC);
+		}
+		RSCINFO(logger,
+				"republished " << toRos.size() << " static transforms to ros and " << toRsb.size() << " to rsb from snapshot");
+	} catch (std::exception& e) {
+		RSCWARN(logger, "Error republishing static transforms. Reason: " << e.what());
+	}
+}
+
+void RctRosBridge::notify() {
+	boost::mutex::scoped_lock lock(mutex);
+	cond.notify_all();
+}
+
+bool RctRosBridge::run() {
+
+	RSCINFO(logger, "start running");
+	republishStatics();
+
+	// run until interrupted
+	while (!interrupted && ros::ok()) {
+		boost::mutex::scoped_lock lock(mutex);
+		// wait for notification
+		RSCTRACE(logger, "wait");
+		cond.wait(lock);
+		RSCTRACE(logger, "notified");
+		while (rsbHandler->hasTransforms()) {
+			RSCDEBUG(logger, "rsb handler has transforms");
+			TransformWrapper t = rsbHandler->nextTransform();
+			if (t.getAuthority() != rsbAuthority) {
+				TransformType type = STATIC;
+				if (!t.isStatic) {
+					type = DYNAMIC;
+					RSCDEBUG(logger, "publish dynamic transform " << t);
+				} else {
+					RSCDEBUG(logger, "publish static transform " << t);
+				}
+				{
+					RCT_ALLOC_PHASE(CONVERT);
+					t.setAuthority(rctAuthorities.get(t.getAuthority()));
+				}
+				try {
+					RCT_PROBE2(rct_bridge, send_begin, "ros", t.getFrameChild().c_str());
+					{
+						RCT_ALLOC_PHASE(PUBLISH);
+						commRos->sendTransform(t, type);
+					}
+					RCT_ALLOC_COUNT_TRANSFORM();
+					RCT_PROBE2(rct_bridge, send_end, "ros", t.getFrameChild().c_str());
+					if (t.isStatic && staticStore) {
+						staticStore->update(StaticTransformStore::TO_ROS, t);
+					}
+				} catch (std::exception& e) {
+					RSCTRACE(logger, "Error sending transform. Reason: " << e.what());
+				}
+			} else {
+				RSCTRACE(logger,
+						"skip bridging of transform from rsb to ros because own authority: " << t.getAuthority());
+			}
+		}
+		while (rosHandler->hasTransforms()) {
+			RSCDEBUG(logger, "ros handler has transforms");
+			TransformWrapper t = rosHandler->nextTransform();
+			if (t.getAuthority() != rosAuthority) {
+				TransformType type = STATIC;
+				if (!t.isStatic) {
+					type = DYNAMIC;
+				}
+				{
+					RCT_ALLOC_PHASE(CONVERT);
+					t.setAuthority(rosAuthorities.get(t.getAuthority()));
+				}
+				try {
+					RCT_PROBE2(rct_bridge, send_begin, "rsb", t.getFrameChild().c_str());
+					{
+						RCT_ALLOC_PHASE(PUBLISH);
+						commRsb->sendTransform(t, type);
+					}
+					RCT_ALLOC_COUNT_TRANSFORM();
+					RCT_PROBE2(rct_bridge, send_end, "rsb", t.getFrameChild().c_str());
+					if (t.isStatic && staticStore) {
+						staticStore->update(StaticTransformStore::TO_RSB, t);
+					}
+				} catch (std::exception& e) {
+					RSCTRACE(logger, "Error sending transform. Reason: " << e.what());
+				}
+			} else {
+				RSCTRACE(logger,
+						"skip bridging of transform from ros to rsb because own authority: " << t.getAuthority());
+			}
+		}
+		RSCTRACE(logger, "loop done");
+	}
+	RSCWARN(logger, "interrupted");
+	RSCINFO(logger, "shutdown");
+	if (ownsRsb) {
+		RSCTRACE(logger, "shutdown rsb communicator");
+		commRsb->shutdown();
+	}
+	RSCTRACE(logger, "shutdown ros communicator");
+	commRos->shutdown();
+	if (staticStore) {
+		staticStore->stop();
+	}
+
+	if (!ros::ok()) {
+		RSCWARN(logger, "Shutdown request received from ROS");
+		cerr << "Shutdown request received from ROS" << endl;
+		return 1;
+	}
+	RSCINFO(logger, "done");
+	return 0;
+}
+void RctRosBridge::interrupt() {
+	interrupted = true;
+	notify();
+}
+
+RctRosBridge::~RctRosBridge() {
+}
+
+void Handler::newTransformAvailable(const Transform& transform, bool isStatic) {
+	RSCTRACE(logger, "newTransformAvailable()");
+	{
+		boost::mutex::scoped_lock lock(mutexHandler);
+		RCT_ALLOC_PHASE(QUEUE);
+		TransformWrapper w(transform, isStatic);
+		transforms.push_back(w);
+		RCT_PROBE3(rct_bridge, enqueue, source.c_str(), transforms.size(), isStatic);
+		if (watchdog && !isStatic && transform.getAuthority() != ownAuthority) {
+			watchdog->update(transform.getFrameChild());
+		}
+	}
+	parent->notify();
+}
+
+void Handler::setWatchdog(StalenessWatchdog::Ptr watchdog, const string& ownAuthority) {
+	boost::mutex::scoped_lock lock(mutexHandler);
+	this->watchdog = watchdog;
+	this->ownAuthority = ownAuthority;
+}
+bool Handler::hasTransforms() {
+	boost::mutex::scoped_lock lock(mutexHandler);
+	return !transforms.empty();
+}
+
+TransformWrapper Handler::nextTransform() {
+	RCT_ALLOC_PHASE(QUEUE);
+	if (!hasTransforms()) {
+		throw std::range_error("no transforms available");
+	}
+	boost::mutex::scoped_lock lock(mutexHandler);
+	TransformWrapper ret = *transforms.begin();
+	transforms.erase(transforms.begin());
+	RCT_PROBE2(rct_bridge, dequeue, source.c_str(), transforms.size());
+	return ret;
+}
+
+} /* namespace rct */
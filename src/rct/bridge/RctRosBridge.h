@@ -0,0 +1,112 @@
+/*
+ * RctRosBridge.h
+ *
+ *  Created on: Dec 16, 2014
+ *      Author: leon
+ */
+
+#pragma once
+#include <string>
+#include <vector>
+#include <rct/impl/TransformCommunicator.h>
+#include "StaticTransformStore.h"
+#include "../monitor/StalenessWatchdog.h"
+#include "../util/NameInterner.h"
+#include <boost/thread.hpp>
+#include <rsc/logging/Logger.h>
+
+namespace rct {
+
+class RctRosBridge;
+
+class TransformWrapper: public Transform {
+public:
+	TransformWrapper(const Transform& t, bool isStatic) :
+			Transform(t), isStatic(isStatic) {
+	}
+	bool isStatic;
+};
+
+class Handler: public TransformListener {
+public:
+	typedef boost::shared_ptr<Handler> Ptr;
+	Handler(RctRosBridge* parent, const std::string &loggerSuffix = "") :
+			parent(parent), source(loggerSuffix),
+			logger(
+					rsc::logging::Logger::getLogger(
+							std::string("rct.RctRosBridge.Handler") + loggerSuffix)) {
+	}
+	virtual ~Handler() {
+	}
+	void newTransformAvailable(const Transform& transform, bool isStatic);
+	/**
+	 * Reports every dynamic transform not sent by ownAuthority, i.e. not
+	 * bridged by ourselves, to the watchdog.
+	 */
+	void setWatchdog(StalenessWatchdog::Ptr watchdog, const std::string& ownAuthority);
+	bool hasTransforms();
+	TransformWrapper nextTransform();
+private:
+	RctRosBridge* parent;
+	std::string source;
+	boost::mutex mutexHandler;
+	std::vector<TransformWrapper> transforms;
+	StalenessWatchdog::Ptr watchdog;
+	std::string ownAuthority;
+	rsc::logging::LoggerPtr logger;
+};
+
+class RctRosBridge {
+public:
+	RctRosBridge(const std::string &name = "rct-ros-bridge", bool rosLegacyMode = true, long rosLegacyIntervalMSec = 100);
+	/**
+	 * Bridges through an initialized rsb communicator owned by the caller. The
+	 * caller registers getRsbListener() wherever the transforms to bridge
+	 * arrive.
+	 */
+	RctRosBridge(const std::string &name, TransformCommunicator::Ptr sharedRsb, bool rosLegacyMode = true, long rosLegacyIntervalMSec = 100);
+	virtual ~RctRosBridge();
+
+	TransformListener::Ptr getRsbListener() const;
+
+	/**
+	 * Keeps the bridged static transforms in the store. run() first
+	 * republishes what the store restored from its last snapshot, live
+	 * transforms replace them as they arrive. Call before run().
+	 */
+	void setStaticStore(StaticTransformStore::Ptr store);
+
+	/**
+	 * Watches the dynamic edges arriving from both sides. Edges are keyed by
+	 * child frame.
+	 */
+	void setWatchdog(StalenessWatchdog::Ptr watchdog);
+
+	bool run();
+	void interrupt();
+	void notify();
+private:
+	void initRos(const std::string &name, bool rosLegacyMode, long rosLegacyIntervalMSec);
+	void republishStatics();
+
+	TransformCommunicator::Ptr commRsb;
+	TransformCommunicator::Ptr commRos;
+	Handler::Ptr rosHandler;
+	Handler::Ptr rsbHandler;
+	bool interrupted;
+	bool ownsRsb;
+	StaticTransformStore::Ptr staticStore;
+
+	// resolved once, the loop in run() compares and prefixes every transform
+	std::string rsbAuthority;
+	std::string rosAuthority;
+	PrefixedNames rctAuthorities;
+	PrefixedNames rosAuthorities;
+
+	boost::condition_variable cond;
+	boost::mutex mutex;
+
+	static rsc::logging::LoggerPtr logger;
+};
+
+} /* namespace rct */
@@ -0,0 +1,226 @@
+/*
+ * StaticTransformStore.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: lziegler
+ */
+
+#include "StaticTransformStore.h"
+#include "../log/TransformLog.h"
+#include "../util/Clock.h"
+
+#include <boost/algorithm/string/predicate.hpp>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <fcntl.h>
+#include <unistd.h>
+
+using namespace std;
+
+namespace rct {
+
+rsc::logging::LoggerPtr StaticTransformStore::logger = rsc::logging::Logger::getLogger(
+		"rct.StaticTransformStore");
+
+const long StaticTransformStore::DEFAULT_INTERVAL_MSEC = 1000;
+const long StaticTransformStore::DEFAULT_GRACE_MSEC = 30000;
+
+namespace {
+
+/**
+ * Flushes a file or directory to disk. fsync() applies to the file, not to
+ * the descriptor, so a new one does after the writer closed its own.
+ */
+void syncToDisk(const string& path) {
+	int fd = open(path.c_str(), O_RDONLY);
+	if (fd < 0) {
+		throw runtime_error("cannot open " + path + ": " + strerror(errno));
+	}
+	if (fsync(fd) != 0) {
+		int error = errno;
+		close(fd);
+		throw runtime_error("cannot sync " + path + ": " + strerror(error));
+	}
+	close(fd);
+}
+
+string directoryOf(const string& file) {
+	string::size_type slash = file.rfind('/');
+	if (slash == string::npos) {
+		return ".";
+	}
+	return slash == 0 ? "/" : file.substr(0, slash);
+}
+
+}  // namespace
+
+StaticTransformStore::StaticTransformStore(const string& file, long intervalMSec,
+		long graceMSec) :
+		file(file), interval(boost::posix_time::milliseconds(intervalMSec)), expiry(
+				monotonicNanos() + boost::uint64_t(graceMSec) * 1000000), dirty(false), stopped(false) {
+	load();
+	writer = boost::thread(&StaticTransformStore::run, this);
+}
+
+StaticTransformStore::~StaticTransformStore() {
+	stop();
+}
+
+void StaticTransformStore::load() {
+	if (access(file.c_str(), F_OK) != 0) {
+		RSCINFO(logger, "no static transform snapshot at " << file);
+		return;
+	}
+	try {
+		TransformLogReader reader(file);
+		TransformLogRecord record;
+		while (reader.next(record)) {
+			const string& authority = record.transform.getAuthority();
+			Direction direction;
+			if (boost::starts_with(authority, "rct:")) {
+				direction = TO_ROS;
+			} else if (boost::starts_with(authority, "ros:")) {
+				direction = TO_RSB;
+			} else {
+				RSCWARN(logger,
+						"skip snapshot transform with unknown authority " << authority << ": " << record.transform);
+				continue;
+			}
+			transforms[make_pair(direction, record.transform.getFrameChild())] = record.transform;
+		}
+	} catch (std::exception& e) {
+		RSCWARN(logger, "ignoring static transform snapshot " << file << ": " << e.what());
+		transforms.clear();
+		return;
+	}
+	Map::const_iterator it;
+	for (it = transforms.begin(); it != transforms.end(); ++it) {
+		loaded.push_back(it->second);
+		unconfirmed.insert(it->first);
+	}
+	RSCINFO(logger, "loaded " << loaded.size() << " static transforms from " << file);
+}
+
+vector<Transform> StaticTransformStore::restored(Direction direction) const {
+	boost::mutex::scoped_lock lock(mutex);
+	const char* prefix = direction == TO_ROS ? "rct:" : "ros:";
+	vector<Transform> result;
+	vector<Transform>::const_iterator it;
+	for (it = loaded.begin(); it != loaded.end(); ++it) {
+		if (boost::starts_with(it->getAuthority(), prefix)) {
+			result.push_back(*it);
+		}
+	}
+	return result;
+}
+
+void StaticTransformStore::update(Direction direction, const Transform& transform) {
+	boost::mutex::scoped_lock lock(mutex);
+	Key key(direction, transform.getFrameChild());
+	unconfirmed.erase(key);
+	Transform& stored = transforms[key];
+	if (stored.getFrameParent() == transform.getFrameParent()
+			&& stored.getAuthority() == transform.getAuthority()
+			&& stored.getTransform().matrix() == transform.getTransform().matrix()) {
+		return;
+	}
+	RSCDEBUG(logger, "static transform changed: " << transform);
+	stored = transform;
+	dirty = true;
+}
+
+size_t StaticTransformStore::size() const {
+	boost::mutex::scoped_lock lock(mutex);
+	return transforms.size();
+}
+
+void StaticTransformStore::stop() {
+	{
+		boost::mutex::scoped_lock lock(mutex);
+		if (stopped) {
+			return;
+		}
+		stopped = true;
+		cond.notify_all();
+	}
+	writer.join();
+}
+
+void StaticTransformStore::expireRestored() {
+	set<Key>::const_iterator it;
+	for (it = unconfirmed.begin(); it != unconfirmed.end(); ++it) {
+		RSCDEBUG(logger, "static transform not seen since startup: " << transforms[*it]);
+		transforms.erase(*it);
+	}
+	RSCINFO(logger,
+			"dropping " << unconfirmed.size() << " restored static transforms not seen since startup");
+	unconfirmed.clear();
+	dirty = true;
+}
+
+void StaticTransformStore::run() {
+	boost::mutex::scoped_lock lock(mutex);
+	while (true) {
+		if (!stopped) {
+			cond.timed_wait(lock, interval);
+		}
+		// without live traffic, e.g. when stopped early, keep them
+		if (!stopped && !unconfirmed.empty() && monotonicNanos() >= expiry) {
+			expireRestored();
+		}
+		if (dirty) {
+			vector<Transform> snapshot;
+			Map::const_iterator it;
+			for (it = transforms.begin(); it != transforms.end(); ++it) {
+				snapshot.push_back(it->second);
+			}
+			dirty = false;
+			lock.unlock();
+			try {
+				write(snapshot);
+			} catch (std::exception& e) {
+				RSCWARN(logger, "cannot write static transform snapshot: " << e.what());
+				lock.lock();
+				dirty = true;
+				if (stopped) {
+					return;
+				}
+				continue;
+			}
+			lock.lock();
+		}
+		if (stopped) {
+			return;
+		}
+	}
+}
+
+void StaticTransformStore::write(const vector<Transform>& snapshot) {
+	string tmp = file + ".tmp";
+	{
+		TransformLogWriter out(tmp);
+		vector<Transform>::const_iterator it;
+		for (it = snapshot.begin(); it != snapshot.end(); ++it) {
+			out.newTransformAvailable(*it, true);
+		}
+		out.close();
+	}
+	// the writer logs its errors instead of throwing, so read the file back
+	// before it replaces the last good snapshot
+	TransformLogReader check(tmp);
+	if (!check.complete() || check.recordCount() != snapshot.size()) {
+		throw runtime_error("incomplete snapshot in " + tmp);
+	}
+	// the data has to be on disk before the rename, and the rename before
+	// the snapshot counts as written
+	syncToDisk(tmp);
+	if (rename(tmp.c_str(), file.c_str()) != 0) {
+		throw runtime_error("cannot rename " + tmp + ": " + strerror(errno));
+	}
+	syncToDisk(directoryOf(file));
+	RSCDEBUG(logger, "wrote " << snapshot.size() << " static transforms to " << file);
+}
+
+}  // namespace rct
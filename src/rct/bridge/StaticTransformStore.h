@@ -0,0 +1,106 @@
+/*
+ * StaticTransformStore.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: lziegler
+ */
+
+#pragma once
+
+#include <rct/Transform.h>
+#include <rsc/logging/Logger.h>
+
+#include <boost/shared_ptr.hpp>
+#include <boost/thread.hpp>
+#include <map>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace rct {
+
+/**
+ * Persists the static transforms a bridge has forwarded, so that a restarted
+ * bridge can republish them at once instead of waiting for their publishers
+ * to send them again.
+ *
+ * The file is a transform log as written by rct-record. The direction of a
+ * transform is not stored separately: the bridge prefixes the authority of
+ * everything it forwards, "rct:" towards ROS and "ros:" towards RSB, and the
+ * store relies on that prefix when loading.
+ *
+ * update() only touches memory. A background thread rewrites the file at
+ * most once per interval if something changed, through a temporary file that
+ * is synced to disk before rename(), so a crash or power loss leaves either
+ * the old or the new snapshot.
+ *
+ * A restored transform that is not forwarded again within the grace period
+ * after startup, e.g. because its publisher is gone, is dropped from the
+ * snapshot. It was republished once, but is not carried on forever.
+ */
+class StaticTransformStore {
+public:
+	typedef boost::shared_ptr<StaticTransformStore> Ptr;
+
+	enum Direction {
+		TO_ROS, TO_RSB
+	};
+
+	static const long DEFAULT_INTERVAL_MSEC;
+	static const long DEFAULT_GRACE_MSEC;
+
+	/**
+	 * Loads the snapshot if the file exists and starts the writer thread. An
+	 * unreadable snapshot is logged and ignored.
+	 */
+	StaticTransformStore(const std::string& file, long intervalMSec = DEFAULT_INTERVAL_MSEC,
+			long graceMSec = DEFAULT_GRACE_MSEC);
+	virtual ~StaticTransformStore();
+
+	/**
+	 * The transforms loaded at construction that go in the given direction.
+	 */
+	std::vector<Transform> restored(Direction direction) const;
+
+	/**
+	 * Records a forwarded static transform, replacing the one of the same
+	 * child frame and direction. Transforms that only differ in their stamp
+	 * do not cause a write, as static transforms are resent periodically, but
+	 * confirm a restored one.
+	 */
+	void update(Direction direction, const Transform& transform);
+
+	/**
+	 * Writes pending changes and stops the writer thread.
+	 */
+	void stop();
+
+	size_t size() const;
+
+private:
+	typedef std::pair<Direction, std::string> Key;
+	typedef std::map<Key, Transform> Map;
+
+	void load();
+	void expireRestored();
+	void run();
+	void write(const std::vector<Transform>& transforms);
+
+	std::string file;
+	boost::posix_time::time_duration interval;
+	Map transforms;
+	std::vector<Transform> loaded;
+	/** restored transforms not forwarded since startup */
+	std::set<Key> unconfirmed;
+	boost::uint64_t expiry;
+	bool dirty;
+	bool stopped;
+	mutable boost::mutex mutex;
+	boost::condition_variable cond;
+	boost::thread writer;
+
+	static rsc::logging::LoggerPtr logger;
+};
+
+}  // namespace rct
@@ -0,0 +1,182 @@
+/*
+ * PoseConverter.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: lziegler
+ */
+
+#include "PoseConverter.h"
+#include "../util/AllocationCounter.h"
+#include "../util/Probes.h"
+
+#define BOOST_SIGNALS_NO_DEPRECATION_WARNING
+#include <rsb/Factory.h>
+#include <rsb/Handler.h>
+#include <rsb/MetaData.h>
+#include <rsb/converter/ProtocolBufferConverter.h>
+#include <rsb/converter/Repository.h>
+
+#include <rst/geometry/Pose.pb.h>
+
+#include <boost/thread/once.hpp>
+
+using namespace std;
+using namespace rsb;
+using namespace rsb::converter;
+using namespace rst::geometry;
+
+namespace rct {
+
+rsc::logging::LoggerPtr PoseConverter::logger = rsc::logging::Logger::getLogger(
+		"rct.PoseConverter");
+
+namespace {
+
+Converter<string>::Ptr converterPose;
+boost::once_flag converterFlag = BOOST_ONCE_INIT;
+
+void registerPoseConverter() {
+	converterPose = Converter<string>::Ptr(new ProtocolBufferConverter<Pose>());
+	converterRepository<string>()->registerConverter(converterPose);
+}
+
+class ConverterHandler: public Handler {
+public:
+	ConverterHandler(PoseConverter* converter) :
+			converter(converter) {
+	}
+	void handle(EventPtr event) {
+		converter->handleEvent(event);
+	}
+
+private:
+	PoseConverter* converter;
+};
+
+Transform poseToTransform(const Pose& p, const ParserResultMessage& message,
+		boost::uint64_t time_usec) {
+	boost::posix_time::ptime time(boost::gregorian::date(1970, 1, 1));
+	time += boost::posix_time::microseconds(time_usec);
+
+	// read data
+	double x = p.translation().x();
+	double y = p.translation().y();
+	double z = p.translation().z();
+	double qw = p.rotation().qw();
+	double qx = p.rotation().qx();
+	double qy = p.rotation().qy();
+	double qz = p.rotation().qz();
+
+	// create a transform
+	Eigen::Vector3d translation(x, y, z);
+	Eigen::Quaterniond rotation(qw, qx, qy, qz);
+	Eigen::Affine3d affine = Eigen::Affine3d().fromPositionOrientationScale(translation, rotation,
+			Eigen::Vector3d::Ones());
+	Transform transform(affine, message.parent, message.child, time);
+	transform.setAuthority(message.authority);
+	return transform;
+}
+
+}  // namespace
+
+PoseConverter::PoseConverter(TransformCommunicator::Ptr comm) :
+		comm(comm) {
+}
+
+PoseConverter::~PoseConverter() {
+	stop();
+}
+
+void PoseConverter::registerConverters() {
+	boost::call_once(&registerPoseConverter, converterFlag);
+}
+
+void PoseConverter::addMessages(const vector<ParserResultMessage>& messages) {
+	vector<ParserResultMessage>::const_iterator msgIt;
+	for (msgIt = messages.begin(); msgIt != messages.end(); ++msgIt) {
+		messageMapping[Scope(msgIt->scope)] = *msgIt;
+	}
+}
+
+size_t PoseConverter::mappingCount() const {
+	return messageMapping.size();
+}
+
+void PoseConverter::start() {
+	start(getFactory().getDefaultParticipantConfig());
+}
+
+void PoseConverter::start(const ParticipantConfig& config) {
+	registerConverters();
+
+	Factory& factory = getFactory();
+	HandlerPtr handler(new ConverterHandler(this));
+	map<Scope, ParserResultMessage>::iterator msgIt;
+	for (msgIt = messageMapping.begin(); msgIt != messageMapping.end(); ++msgIt) {
+		const ParserResultMessage& msg = msgIt->second;
+		RSCINFO(logger,
+				"converting " << msg.scope << " to " << msg.parent << " -> " << msg.child << " (" << msg.authority << ")");
+		ListenerPtr listener = factory.createListener(msgIt->first, config);
+		listener->addHandler(handler);
+		listeners.push_back(listener);
+	}
+}
+
+void PoseConverter::stop() {
+	listeners.clear();
+}
+
+const ParserResultMessage* PoseConverter::findMessage(const Scope& scope) const {
+	// most events arrive on a configured scope itself
+	map<Scope, ParserResultMessage>::const_iterator msgIt = messageMapping.find(scope);
+	if (msgIt != messageMapping.end()) {
+		return &msgIt->second;
+	}
+	// scopes are ordered by their string form, in which a super scope is a
+	// prefix, so walking backwards finds the longest super scope first
+	map<Scope, ParserResultMessage>::const_reverse_iterator rIt;
+	for (rIt = messageMapping.rbegin(); rIt != messageMapping.rend(); ++rIt) {
+		if (rIt->first.isSuperScopeOf(scope)) {
+			return &rIt->second;
+		}
+	}
+	return 0;
+}
+
+void PoseConverter::setWatchdog(StalenessWatchdog::Ptr watchdog) {
+	this->watchdog = watchdog;
+}
+
+void PoseConverter::handleEvent(EventPtr e) {
+	RCT_ALLOC_PHASE(RECEIVE);
+
+	boost::uint64_t createTime = e->getMetaData().getCreateTime();
+	RCT_PROBE1(rct_from_rst, event_received, createTime);
+
+	// find message for source
+	Scope scope = e->getScope();
+	const ParserResultMessage* message = findMessage(scope);
+	if (!message) {
+		RSCERROR(logger, "No known message configuration for scope: " << scope);
+		return;
+	}
+
+	if (e->getType() == converterPose->getDataType()) {
+		RCT_ALLOC_PHASE(CONVERT);
+		Transform transform = poseToTransform(*boost::static_pointer_cast<Pose>(e->getData()),
+				*message, createTime);
+
+		// publish the transform
+		{
+			RCT_ALLOC_PHASE(PUBLISH);
+			comm->sendTransform(transform, rct::DYNAMIC);
+		}
+		RCT_ALLOC_COUNT_TRANSFORM();
+		RCT_PROBE2(rct_from_rst, transform_published, message->child.c_str(), createTime);
+		if (watchdog) {
+			watchdog->update(message->child);
+		}
+	}
+}
+
+}  // namespace rct
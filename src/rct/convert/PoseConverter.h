@@ -0,0 +1,77 @@
+/*
+ * PoseConverter.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: lziegler
+ */
+
+#pragma once
+
+#include "../parsers/Parser.h"
+#include "../monitor/StalenessWatchdog.h"
+
+#include <rct/impl/TransformCommunicator.h>
+#include <rsb/Event.h>
+#include <rsb/Listener.h>
+#include <rsb/ParticipantConfig.h>
+#include <rsb/Scope.h>
+#include <rsc/logging/Logger.h>
+
+#include <map>
+#include <vector>
+
+namespace rct {
+
+/**
+ * Converts rst::geometry::Pose events to dynamic transforms. Each configured
+ * message maps a scope, including its sub scopes, to a parent/child pair and
+ * an authority. The event create time becomes the transform stamp.
+ */
+class PoseConverter {
+public:
+	typedef boost::shared_ptr<PoseConverter> Ptr;
+
+	PoseConverter(TransformCommunicator::Ptr comm);
+	virtual ~PoseConverter();
+
+	void addMessages(const std::vector<ParserResultMessage>& messages);
+	size_t mappingCount() const;
+
+	/**
+	 * Reports every converted pose to the watchdog, keyed by the child frame
+	 * of its mapping. Call before start().
+	 */
+	void setWatchdog(StalenessWatchdog::Ptr watchdog);
+
+	/**
+	 * Creates one listener per configured scope.
+	 */
+	void start();
+	void start(const rsb::ParticipantConfig& config);
+	void stop();
+
+	void handleEvent(rsb::EventPtr event);
+
+	/**
+	 * Registers the rst converters with the rsb repository. Safe to call
+	 * several times.
+	 */
+	static void registerConverters();
+
+private:
+	/**
+	 * The configuration of the scope or its closest, i.e. longest, configured
+	 * super scope, 0 if there is none. Points into messageMapping, so nothing is copied
+	 * per event.
+	 */
+	const ParserResultMessage* findMessage(const rsb::Scope& scope) const;
+
+	TransformCommunicator::Ptr comm;
+	std::map<rsb::Scope, ParserResultMessage> messageMapping;
+	std::vector<rsb::ListenerPtr> listeners;
+	StalenessWatchdog::Ptr watchdog;
+
+	static rsc::logging::LoggerPtr logger;
+};
+
+}  // namespace rct
@@ -0,0 +1,63 @@
+/*
+ * PublisherCommunicator.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: lziegler
+ */
+
+#pragma once
+
+#include <rct/TransformPublisher.h>
+#include <rct/impl/TransformCommunicator.h>
+
+#include <ostream>
+#include <vector>
+
+namespace rct {
+
+/**
+ * Sends through a TransformPublisher of the transformer factory, so that the
+ * communication type and the other settings of the factory's configuration
+ * apply. Only the sending half of TransformCommunicator is supported,
+ * listeners are ignored.
+ */
+class PublisherCommunicator: public TransformCommunicator {
+public:
+	typedef boost::shared_ptr<PublisherCommunicator> Ptr;
+
+	PublisherCommunicator(TransformPublisher::Ptr publisher) :
+			publisher(publisher) {
+	}
+	virtual ~PublisherCommunicator() {
+	}
+
+	/** the publisher is initialized by the factory */
+	void init(const TransformerConfig& conf) {
+	}
+	bool sendTransform(const Transform& transform, TransformType type) {
+		return publisher->sendTransform(transform, type);
+	}
+	bool sendTransform(const std::vector<Transform>& transforms, TransformType type) {
+		return publisher->sendTransform(transforms, type);
+	}
+	void shutdown() {
+	}
+	std::string getAuthorityName() const {
+		return publisher->getAuthorityName();
+	}
+
+	void addTransformListener(const TransformListener::Ptr& listener) {
+	}
+	void addTransformListener(const std::vector<TransformListener::Ptr>& listeners) {
+	}
+	void removeTransformListener(const TransformListener::Ptr& listener) {
+	}
+	void printContents(std::ostream& stream) const {
+		stream << "publisher of " << publisher->getAuthorityName();
+	}
+
+private:
+	TransformPublisher::Ptr publisher;
+};
+
+}  // namespace rct
@@ -0,0 +1,172 @@
+/*
+ * TransformHub.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: lziegler
+ */
+
+#include "TransformHub.h"
+#include "../util/Clock.h"
+
+#include <algorithm>
+
+using namespace std;
+
+namespace rct {
+
+rsc::logging::LoggerPtr TransformHub::logger = rsc::logging::Logger::getLogger("rct.TransformHub");
+
+const long TransformHub::ECHO_WINDOW_MSEC = 2000;
+
+namespace {
+
+/**
+ * Passes transforms from the communicator on, except those sent by the hub.
+ */
+class RemoteListener: public TransformListener {
+public:
+	RemoteListener(const TransformHub* hub, const TransformListener::Ptr& listener) :
+			hub(hub), listener(listener) {
+	}
+	void newTransformAvailable(const Transform& transform, bool isStatic) {
+		if (!hub->isEcho(transform)) {
+			listener->newTransformAvailable(transform, isStatic);
+		}
+	}
+	const TransformListener::Ptr& target() const {
+		return listener;
+	}
+
+private:
+	const TransformHub* hub;
+	TransformListener::Ptr listener;
+};
+
+}  // namespace
+
+TransformHub::TransformHub(TransformCommunicator::Ptr comm) :
+		comm(comm) {
+}
+
+TransformHub::~TransformHub() {
+}
+
+void TransformHub::init(const TransformerConfig& conf) {
+	comm->init(conf);
+}
+
+void TransformHub::remember(const Transform& transform) {
+	boost::uint64_t now = monotonicNanos();
+	boost::mutex::scoped_lock lock(mutex);
+	expire(now);
+	Sent key;
+	key.parent = frames.intern(transform.getFrameParent());
+	key.child = frames.intern(transform.getFrameChild());
+	key.stamp = transform.getTime();
+	// static transforms are resent with the same stamp
+	sent[key] = now;
+	sendOrder.push_back(make_pair(now, key));
+}
+
+void TransformHub::expire(boost::uint64_t now) {
+	boost::uint64_t window = boost::uint64_t(ECHO_WINDOW_MSEC) * 1000000;
+	while (!sendOrder.empty() && sendOrder.front().first + window < now) {
+		map<Sent, boost::uint64_t>::iterator it = sent.find(sendOrder.front().second);
+		// unless it was sent again since
+		if (it != sent.end() && it->second == sendOrder.front().first) {
+			sent.erase(it);
+		}
+		sendOrder.pop_front();
+	}
+}
+
+vector<TransformListener::Ptr> TransformHub::currentListeners() const {
+	boost::mutex::scoped_lock lock(mutex);
+	return listeners;
+}
+
+bool TransformHub::sendTransform(const Transform& transform, TransformType type) {
+	remember(transform);
+	vector<TransformListener::Ptr> targets = currentListeners();
+	for (vector<TransformListener::Ptr>::iterator it = targets.begin(); it != targets.end(); ++it) {
+		(*it)->newTransformAvailable(transform, type == STATIC);
+	}
+	return comm->sendTransform(transform, type);
+}
+
+bool TransformHub::sendTransform(const vector<Transform>& transforms, TransformType type) {
+	vector<TransformListener::Ptr> targets = currentListeners();
+	vector<Transform>::const_iterator t;
+	for (t = transforms.begin(); t != transforms.end(); ++t) {
+		remember(*t);
+		for (vector<TransformListener::Ptr>::iterator it = targets.begin(); it != targets.end();
+				++it) {
+			(*it)->newTransformAvailable(*t, type == STATIC);
+		}
+	}
+	return comm->sendTransform(transforms, type);
+}
+
+void TransformHub::addTransformListener(const TransformListener::Ptr& listener) {
+	TransformListener::Ptr remote(new RemoteListener(this, listener));
+	{
+		boost::mutex::scoped_lock lock(mutex);
+		listeners.push_back(listener);
+		remoteListeners.push_back(remote);
+	}
+	comm->addTransformListener(remote);
+}
+
+void TransformHub::addTransformListener(const vector<TransformListener::Ptr>& listeners) {
+	vector<TransformListener::Ptr>::const_iterator it;
+	for (it = listeners.begin(); it != listeners.end(); ++it) {
+		addTransformListener(*it);
+	}
+}
+
+void TransformHub::removeTransformListener(const TransformListener::Ptr& listener) {
+	TransformListener::Ptr remote;
+	{
+		boost::mutex::scoped_lock lock(mutex);
+		vector<TransformListener::Ptr>::iterator it = find(listeners.begin(), listeners.end(),
+				listener);
+		if (it == listeners.end()) {
+			return;
+		}
+		size_t index = it - listeners.begin();
+		remote = remoteListeners[index];
+		listeners.erase(it);
+		remoteListeners.erase(remoteListeners.begin() + index);
+	}
+	comm->removeTransformListener(remote);
+}
+
+string TransformHub::getAuthorityName() const {
+	return comm->getAuthorityName();
+}
+
+void TransformHub::shutdown() {
+	comm->shutdown();
+}
+
+void TransformHub::printContents(ostream& stream) const {
+	boost::mutex::scoped_lock lock(mutex);
+	stream << "hub of " << comm->getAuthorityName() << " with " << listeners.size()
+			<< " listeners and " << sent.size() << " transforms awaiting their echo";
+}
+
+bool TransformHub::isEcho(const Transform& transform) const {
+	boost::uint64_t now = monotonicNanos();
+	boost::mutex::scoped_lock lock(mutex);
+	Sent key;
+	if (!frames.find(transform.getFrameParent(), key.parent)
+			|| !frames.find(transform.getFrameChild(), key.child)) {
+		return false;
+	}
+	key.stamp = transform.getTime();
+	map<Sent, boost::uint64_t>::const_iterator it = sent.find(key);
+	return it != sent.end()
+			&& it->second + boost::uint64_t(ECHO_WINDOW_MSEC) * 1000000 >= now;
+}
+
+}  // namespace rct
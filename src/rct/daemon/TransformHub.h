@@ -0,0 +1,98 @@
+/*
+ * TransformHub.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: lziegler
+ */
+
+#pragma once
+
+#include "../util/NameInterner.h"
+
+#include <rct/impl/TransformCommunicator.h>
+#include <rsc/logging/Logger.h>
+
+#include <boost/cstdint.hpp>
+#include <boost/thread/mutex.hpp>
+#include <deque>
+#include <map>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace rct {
+
+/**
+ * Shares one communicator between several modules of a process. Transforms
+ * sent through the hub go out through the communicator and are handed to
+ * the hub's listeners directly, without a round trip through the transport.
+ * Listeners see transforms from other processes as well, but not the echo of
+ * transforms sent through this hub.
+ *
+ * The communicator does not pass on who sent a transform, so echoes are
+ * recognized by parent, child and stamp of the transforms sent within the
+ * last ECHO_WINDOW_MSEC. Another process may use the same authorities.
+ */
+class TransformHub: public TransformCommunicator {
+public:
+	typedef boost::shared_ptr<TransformHub> Ptr;
+
+	TransformHub(TransformCommunicator::Ptr comm);
+	virtual ~TransformHub();
+
+	void init(const TransformerConfig& conf);
+	bool sendTransform(const Transform& transform, TransformType type);
+	bool sendTransform(const std::vector<Transform>& transforms, TransformType type);
+
+	void addTransformListener(const TransformListener::Ptr& listener);
+	void addTransformListener(const std::vector<TransformListener::Ptr>& listeners);
+	void removeTransformListener(const TransformListener::Ptr& listener);
+
+	std::string getAuthorityName() const;
+	void shutdown();
+	void printContents(std::ostream& stream) const;
+
+	/**
+	 * True if a transform with the same parent, child and stamp was sent
+	 * through the hub recently.
+	 */
+	bool isEcho(const Transform& transform) const;
+
+	/** how long a sent transform is expected to come back */
+	static const long ECHO_WINDOW_MSEC;
+
+private:
+	struct Sent {
+		NameInterner::Id parent;
+		NameInterner::Id child;
+		boost::posix_time::ptime stamp;
+
+		bool operator<(const Sent& other) const {
+			if (child != other.child) {
+				return child < other.child;
+			}
+			if (parent != other.parent) {
+				return parent < other.parent;
+			}
+			return stamp < other.stamp;
+		}
+	};
+
+	void remember(const Transform& transform);
+	void expire(boost::uint64_t now);
+	std::vector<TransformListener::Ptr> currentListeners() const;
+
+	TransformCommunicator::Ptr comm;
+	std::vector<TransformListener::Ptr> listeners;
+	std::vector<TransformListener::Ptr> remoteListeners;
+	NameInterner frames;
+	/** monotonic time of the last send of every transform in the window */
+	std::map<Sent, boost::uint64_t> sent;
+	std::deque<std::pair<boost::uint64_t, Sent> > sendOrder;
+	mutable boost::mutex mutex;
+
+	static rsc::logging::LoggerPtr logger;
+};
+
+}  // namespace rct
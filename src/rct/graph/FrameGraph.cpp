@@ -0,0 +1,175 @@
+/*
+ * FrameGraph.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: lziegler
+ */
+
+#include "FrameGraph.h"
+
+#include <algorithm>
+#include <sstream>
+#include <stdexcept>
+
+using namespace std;
+
+namespace rct {
+
+rsc::logging::LoggerPtr FrameGraph::logger = rsc::logging::Logger::getLogger("rct.FrameGraph");
+
+FrameGraph::FrameGraph() {
+}
+
+FrameGraph::~FrameGraph() {
+}
+
+void FrameGraph::addTransform(const Transform& transform) {
+	const string& parent = transform.getFrameParent();
+	const string& child = transform.getFrameChild();
+
+	if (parent == child) {
+		stringstream ss;
+		ss << "Transform from frame \"" << parent << "\" to itself";
+		throw invalid_argument(ss.str());
+	}
+
+	map<string, Edge>::iterator existing = parents.find(child);
+	if (existing != parents.end()) {
+		if (existing->second.parent != parent) {
+			stringstream ss;
+			ss << "Frame \"" << child << "\" has multiple parents: \"" << existing->second.parent
+					<< "\" and \"" << parent << "\"";
+			throw invalid_argument(ss.str());
+		}
+		RSCWARN(logger, "duplicate transform " << parent << " -> " << child << ". Using the last one.");
+		existing->second.transform = transform;
+		return;
+	}
+
+	// walking up from the parent must not reach the child
+	string frame = parent;
+	map<string, Edge>::const_iterator it;
+	while ((it = parents.find(frame)) != parents.end()) {
+		frame = it->second.parent;
+		if (frame == child) {
+			stringstream ss;
+			ss << "Transform " << parent << " -> " << child << " closes a cycle";
+			throw invalid_argument(ss.str());
+		}
+	}
+
+	Edge edge;
+	edge.parent = parent;
+	edge.transform = transform;
+	parents[child] = edge;
+	children[parent].push_back(child);
+	if (children.find(child) == children.end()) {
+		children[child] = vector<string>();
+	}
+}
+
+void FrameGraph::addTransforms(const vector<Transform>& transforms) {
+	vector<Transform>::const_iterator it;
+	for (it = transforms.begin(); it != transforms.end(); ++it) {
+		addTransform(*it);
+	}
+}
+
+bool FrameGraph::hasFrame(const string& frame) const {
+	return children.find(frame) != children.end();
+}
+
+vector<string> FrameGraph::roots() const {
+	vector<string> result;
+	map<string, vector<string> >::const_iterator it;
+	for (it = children.begin(); it != children.end(); ++it) {
+		if (parents.find(it->first) == parents.end()) {
+			result.push_back(it->first);
+		}
+	}
+	return result;
+}
+
+vector<string> FrameGraph::leaves() const {
+	vector<string> result;
+	map<string, vector<string> >::const_iterator it;
+	for (it = children.begin(); it != children.end(); ++it) {
+		if (it->second.empty()) {
+			result.push_back(it->first);
+		}
+	}
+	return result;
+}
+
+unsigned int FrameGraph::depth(const string& frame) const {
+	unsigned int d = 0;
+	string current = frame;
+	map<string, Edge>::const_iterator it;
+	while ((it = parents.find(current)) != parents.end()) {
+		current = it->second.parent;
+		d++;
+	}
+	return d;
+}
+
+string FrameGraph::root(const string& frame) const {
+	string current = frame;
+	map<string, Edge>::const_iterator it;
+	while ((it = parents.find(current)) != parents.end()) {
+		current = it->second.parent;
+	}
+	return current;
+}
+
+Eigen::Affine3d FrameGraph::fromRoot(const string& frame) const {
+	// transforms map child coordinates into parent coordinates, so the chain
+	// is composed from the frame upwards by left multiplication
+	Eigen::Affine3d result = Eigen::Affine3d::Identity();
+	string current = frame;
+	map<string, Edge>::const_iterator it;
+	while ((it = parents.find(current)) != parents.end()) {
+		result = it->second.transform.getTransform() * result;
+		current = it->second.parent;
+	}
+	return result;
+}
+
+boost::posix_time::ptime FrameGraph::latestTime(const string& frame) const {
+	boost::posix_time::ptime latest(boost::posix_time::min_date_time);
+	string current = frame;
+	map<string, Edge>::const_iterator it;
+	while ((it = parents.find(current)) != parents.end()) {
+		latest = max(latest, it->second.transform.getTime());
+		current = it->second.parent;
+	}
+	return latest;
+}
+
+bool FrameGraph::lookup(const string& target, const string& source, Transform& result) const {
+	if (!hasFrame(target) || !hasFrame(source)) {
+		return false;
+	}
+	if (root(target) != root(source)) {
+		return false;
+	}
+	Eigen::Affine3d affine = fromRoot(target).inverse() * fromRoot(source);
+	result = Transform(affine, target, source, max(latestTime(target), latestTime(source)));
+	return true;
+}
+
+vector<Transform> FrameGraph::shortcuts(const string& childPrefix, unsigned int minDepth) const {
+	vector<Transform> result;
+	vector<string> leafFrames = leaves();
+	vector<string>::const_iterator it;
+	for (it = leafFrames.begin(); it != leafFrames.end(); ++it) {
+		if (depth(*it) < minDepth) {
+			continue;
+		}
+		Transform t(fromRoot(*it), root(*it), childPrefix + *it, latestTime(*it));
+		RSCDEBUG(logger, "shortcut: " << t);
+		result.push_back(t);
+	}
+	return result;
+}
+
+}  // namespace rct
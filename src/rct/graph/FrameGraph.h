@@ -0,0 +1,74 @@
+/*
+ * FrameGraph.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: lziegler
+ */
+
+#pragma once
+
+#include <rct/Transform.h>
+#include <rsc/logging/Logger.h>
+
+#include <map>
+#include <string>
+#include <vector>
+
+namespace rct {
+
+/**
+ * Tree of coordinate frames built from a set of transforms.
+ *
+ * Every frame has at most one parent. Adding a transform that gives a frame
+ * a second parent or closes a cycle raises std::invalid_argument.
+ */
+class FrameGraph {
+public:
+	FrameGraph();
+	virtual ~FrameGraph();
+
+	void addTransform(const Transform& transform);
+	void addTransforms(const std::vector<Transform>& transforms);
+
+	bool hasFrame(const std::string& frame) const;
+	std::vector<std::string> roots() const;
+	std::vector<std::string> leaves() const;
+
+	/**
+	 * Number of edges between the frame and its root.
+	 */
+	unsigned int depth(const std::string& frame) const;
+
+	/**
+	 * Composes the transform of source in target, which is the same
+	 * convention as TransformReceiver::lookupTransform(target, source, time).
+	 * Returns false if the frames are unknown or not connected.
+	 */
+	bool lookup(const std::string& target, const std::string& source, Transform& result) const;
+
+	/**
+	 * One transform from the root to each leaf that is at least minDepth edges
+	 * below its root. The child frame of a shortcut is the leaf name with the
+	 * given prefix, so it does not re-parent the leaf itself.
+	 */
+	std::vector<Transform> shortcuts(const std::string& childPrefix,
+			unsigned int minDepth = 2) const;
+
+private:
+	class Edge {
+	public:
+		std::string parent;
+		Transform transform;
+	};
+
+	std::string root(const std::string& frame) const;
+	Eigen::Affine3d fromRoot(const std::string& frame) const;
+	boost::posix_time::ptime latestTime(const std::string& frame) const;
+
+	std::map<std::string, Edge> parents;
+	std::map<std::string, std::vector<std::string> > children;
+
+	static rsc::logging::LoggerPtr logger;
+};
+
+}  // namespace rct
@@ -0,0 +1,202 @@
+/*
+ * GraphExport.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: lziegler
+ */
+
+#include "GraphExport.h"
+#include "TreeLayout.h"
+#include "../util/Json.h"
+
+#include <iomanip>
+#include <map>
+#include <set>
+#include <sstream>
+#include <stdexcept>
+
+using namespace std;
+
+namespace rct {
+
+namespace {
+
+const double SVG_CHAR_WIDTH = 7.5;
+const double SVG_NODE_HEIGHT = 24.0;
+const double SVG_NODE_PADDING = 8.0;
+const double SVG_MARGIN = 20.0;
+
+string dotEscape(const string& value) {
+	string result;
+	for (string::const_iterator it = value.begin(); it != value.end(); ++it) {
+		if (*it == '"' || *it == '\\') {
+			result += '\\';
+		}
+		result += *it;
+	}
+	return result;
+}
+
+string dotString(const string& value) {
+	return "\"" + dotEscape(value) + "\"";
+}
+
+string xmlString(const string& value) {
+	string result;
+	for (string::const_iterator it = value.begin(); it != value.end(); ++it) {
+		switch (*it) {
+		case '&':
+			result += "&amp;";
+			break;
+		case '<':
+			result += "&lt;";
+			break;
+		case '>':
+			result += "&gt;";
+			break;
+		case '"':
+			result += "&quot;";
+			break;
+		default:
+			result += *it;
+		}
+	}
+	return result;
+}
+
+string rateLabel(const EdgeInfo& edge) {
+	if (edge.isStatic) {
+		return "static";
+	}
+	stringstream ss;
+	ss << fixed << setprecision(1) << edge.rate() << " Hz";
+	return ss.str();
+}
+
+double toSeconds(const boost::posix_time::ptime& time) {
+	if (time.is_not_a_date_time()) {
+		return 0.0;
+	}
+	return (time - boost::posix_time::from_time_t(0)).total_microseconds() / 1000000.0;
+}
+
+}  // namespace
+
+GraphExport::Format GraphExport::parseFormat(const string& name) {
+	if (name == "dot") {
+		return DOT;
+	} else if (name == "svg") {
+		return SVG;
+	} else if (name == "json") {
+		return JSON;
+	}
+	throw invalid_argument("unknown export format '" + name + "', expected dot, svg or json");
+}
+
+void GraphExport::write(ostream& out, const vector<EdgeInfo>& edges, Format format) {
+	switch (format) {
+	case DOT:
+		writeDot(out, edges);
+		break;
+	case SVG:
+		writeSvg(out, edges);
+		break;
+	case JSON:
+		writeJson(out, edges);
+		break;
+	}
+}
+
+void GraphExport::writeDot(ostream& out, const vector<EdgeInfo>& edges) {
+	out << "digraph frames {\n";
+	out << "\tnode [shape=box];\n";
+	for (vector<EdgeInfo>::const_iterator it = edges.begin(); it != edges.end(); ++it) {
+		out << "\t" << dotString(it->parent) << " -> " << dotString(it->child) << " [label="
+				<< "\"" << dotEscape(it->authority) << "\\n" << rateLabel(*it) << "\"";
+		if (it->isStatic) {
+			out << ", style=dashed";
+		}
+		out << "];\n";
+	}
+	out << "}\n";
+}
+
+void GraphExport::writeSvg(ostream& out, const vector<EdgeInfo>& edges) {
+	TreeLayout layout(30.0, 90.0);
+	for (vector<EdgeInfo>::const_iterator it = edges.begin(); it != edges.end(); ++it) {
+		layout.setNodeWidth(it->parent, it->parent.size() * SVG_CHAR_WIDTH + 2 * SVG_NODE_PADDING);
+		layout.setNodeWidth(it->child, it->child.size() * SVG_CHAR_WIDTH + 2 * SVG_NODE_PADDING);
+		layout.addEdge(it->parent, it->child);
+	}
+	map<string, TreeLayout::Node> nodes = layout.compute();
+	double width = layout.width() + 2 * SVG_MARGIN;
+	double height = layout.height() + SVG_NODE_HEIGHT + 2 * SVG_MARGIN;
+
+	out << fixed << setprecision(1);
+	out << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n";
+	out << "<svg xmlns=\"http://www.w3.org/2000/svg\" width=\"" << width << "\" height=\""
+			<< height << "\" viewBox=\"" << -SVG_MARGIN << " " << -SVG_MARGIN << " " << width
+			<< " " << height << "\" font-family=\"monospace\" font-size=\"12\">\n";
+	out << "\t<defs><marker id=\"arrow\" markerWidth=\"8\" markerHeight=\"8\" refX=\"8\" "
+			"refY=\"4\" orient=\"auto\"><path d=\"M0,0 L8,4 L0,8 z\"/></marker></defs>\n";
+
+	for (vector<EdgeInfo>::const_iterator it = edges.begin(); it != edges.end(); ++it) {
+		const TreeLayout::Node& parent = nodes[it->parent];
+		const TreeLayout::Node& child = nodes[it->child];
+		double x1 = parent.x;
+		double y1 = parent.y + SVG_NODE_HEIGHT;
+		double x2 = child.x;
+		double y2 = child.y;
+		double middle = (y1 + y2) / 2.0;
+		out << "\t<path d=\"M" << x1 << "," << y1 << " C" << x1 << "," << middle << " " << x2
+				<< "," << middle << " " << x2 << "," << y2 << "\" fill=\"none\" stroke=\""
+				<< (it->isStatic ? "gray" : "black") << "\"";
+		if (it->isStatic) {
+			out << " stroke-dasharray=\"4,3\"";
+		}
+		out << " marker-end=\"url(#arrow)\"/>\n";
+		out << "\t<text x=\"" << (x1 + x2) / 2.0 + 4.0 << "\" y=\"" << middle
+				<< "\" fill=\"dimgray\" font-size=\"10\">" << xmlString(it->authority) << " "
+				<< xmlString(rateLabel(*it)) << "</text>\n";
+	}
+
+	for (map<string, TreeLayout::Node>::const_iterator it = nodes.begin(); it != nodes.end();
+			++it) {
+		const TreeLayout::Node& node = it->second;
+		out << "\t<rect x=\"" << node.x - node.width / 2.0 << "\" y=\"" << node.y
+				<< "\" width=\"" << node.width << "\" height=\"" << SVG_NODE_HEIGHT
+				<< "\" fill=\"white\" stroke=\"black\"/>\n";
+		out << "\t<text x=\"" << node.x << "\" y=\"" << node.y + SVG_NODE_HEIGHT / 2.0 + 4.0
+				<< "\" text-anchor=\"middle\">" << xmlString(node.name) << "</text>\n";
+	}
+	out << "</svg>\n";
+}
+
+void GraphExport::writeJson(ostream& out, const vector<EdgeInfo>& edges) {
+	map<string, vector<const EdgeInfo*> > adjacency;
+	for (vector<EdgeInfo>::const_iterator it = edges.begin(); it != edges.end(); ++it) {
+		adjacency[it->parent].push_back(&*it);
+		adjacency[it->child];
+	}
+
+	out << "{\n\t\"frames\": {";
+	map<string, vector<const EdgeInfo*> >::const_iterator frame;
+	for (frame = adjacency.begin(); frame != adjacency.end(); ++frame) {
+		out << (frame == adjacency.begin() ? "\n" : ",\n");
+		out << "\t\t" << jsonString(frame->first) << ": [";
+		vector<const EdgeInfo*>::const_iterator edge;
+		for (edge = frame->second.begin(); edge != frame->second.end(); ++edge) {
+			const EdgeInfo& e = **edge;
+			out << (edge == frame->second.begin() ? "\n" : ",\n");
+			out << "\t\t\t{\"child\": " << jsonString(e.child) << ", \"authority\": "
+					<< jsonString(e.authority) << ", \"static\": "
+					<< (e.isStatic ? "true" : "false") << ", \"updates\": " << e.updates
+					<< ", \"rate\": " << fixed << setprecision(3) << e.rate()
+					<< ", \"last_stamp\": " << setprecision(6) << toSeconds(e.lastStamp) << "}";
+		}
+		out << (frame->second.empty() ? "]" : "\n\t\t]");
+	}
+	out << "\n\t}\n}\n";
+}
+
+}  // namespace rct
@@ -0,0 +1,55 @@
+/*
+ * GraphExport.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: lziegler
+ */
+
+#pragma once
+
+#include "../monitor/EdgeMonitor.h"
+
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace rct {
+
+/**
+ * Writes the edges collected by an EdgeMonitor as text. All formats are
+ * produced directly, neither graphviz nor any GUI library is involved.
+ * Edges are written in parent/child order, so snapshots of the same
+ * structure can be compared with diff.
+ */
+class GraphExport {
+public:
+	enum Format {
+		DOT, SVG, JSON
+	};
+
+	/**
+	 * Parses "dot", "svg" or "json". Throws std::invalid_argument otherwise.
+	 */
+	static Format parseFormat(const std::string& name);
+
+	static void write(std::ostream& out, const std::vector<EdgeInfo>& edges, Format format);
+
+	/**
+	 * Graphviz digraph, static edges are dashed.
+	 */
+	static void writeDot(std::ostream& out, const std::vector<EdgeInfo>& edges);
+
+	/**
+	 * Standalone SVG drawing laid out with TreeLayout.
+	 */
+	static void writeSvg(std::ostream& out, const std::vector<EdgeInfo>& edges);
+
+	/**
+	 * Adjacency list keyed by parent frame. Every frame has an entry, each
+	 * outgoing edge carries authority, static flag, update count, rate and
+	 * last stamp.
+	 */
+	static void writeJson(std::ostream& out, const std::vector<EdgeInfo>& edges);
+};
+
+}  // namespace rct
@@ -0,0 +1,161 @@
+/*
+ * TreeLayout.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: lziegler
+ */
+
+#include "TreeLayout.h"
+
+#include <algorithm>
+
+using namespace std;
+
+namespace rct {
+
+TreeLayout::TreeLayout(double horizontalGap, double layerHeight) :
+		horizontalGap(horizontalGap), layerHeight(layerHeight), totalWidth(0.0), totalHeight(0.0) {
+}
+
+TreeLayout::~TreeLayout() {
+}
+
+void TreeLayout::setNodeWidth(const string& name, double width) {
+	widths[name] = width;
+}
+
+void TreeLayout::addEdge(const string& parent, const string& child) {
+	children[child];
+	vector<string>& siblings = children[parent];
+	if (find(siblings.begin(), siblings.end(), child) != siblings.end()) {
+		return;
+	}
+	// a frame with several parents stays below the first one
+	if (parents.find(child) != parents.end()) {
+		return;
+	}
+	parents[child] = parent;
+	siblings.insert(lower_bound(siblings.begin(), siblings.end(), child), child);
+}
+
+void TreeLayout::clear() {
+	widths.clear();
+	children.clear();
+	parents.clear();
+}
+
+double TreeLayout::nodeWidth(const string& name) const {
+	map<string, double>::const_iterator it = widths.find(name);
+	return it != widths.end() ? it->second : 1.0;
+}
+
+double TreeLayout::subtreeWidth(const string& name, map<string, double>& cache,
+		set<string>& visiting) const {
+	map<string, double>::const_iterator cached = cache.find(name);
+	if (cached != cache.end()) {
+		return cached->second;
+	}
+	visiting.insert(name);
+	double childrenWidth = 0.0;
+	unsigned int count = 0;
+	const vector<string>& kids = children.find(name)->second;
+	for (vector<string>::const_iterator it = kids.begin(); it != kids.end(); ++it) {
+		if (visiting.count(*it)) {
+			continue;
+		}
+		childrenWidth += subtreeWidth(*it, cache, visiting);
+		count++;
+	}
+	if (count > 1) {
+		childrenWidth += (count - 1) * horizontalGap;
+	}
+	visiting.erase(name);
+	double width = max(nodeWidth(name), childrenWidth);
+	cache[name] = width;
+	return width;
+}
+
+void TreeLayout::place(const string& name, double left, unsigned int depth,
+		const map<string, double>& subtreeWidths, map<string, Node>& result) const {
+	if (result.find(name) != result.end()) {
+		return;
+	}
+	Node& node = result[name];
+	node.name = name;
+	node.width = nodeWidth(name);
+	node.depth = depth;
+	node.y = depth * layerHeight;
+	double width = subtreeWidths.find(name)->second;
+
+	const vector<string>& kids = children.find(name)->second;
+	vector<string> placed;
+	double childrenWidth = 0.0;
+	for (vector<string>::const_iterator it = kids.begin(); it != kids.end(); ++it) {
+		if (result.find(*it) == result.end()) {
+			placed.push_back(*it);
+			childrenWidth += subtreeWidths.find(*it)->second;
+		}
+	}
+	if (placed.empty()) {
+		node.x = left + width / 2.0;
+		return;
+	}
+	childrenWidth += (placed.size() - 1) * horizontalGap;
+
+	// mark the node as placed before descending, which stops cycles
+	node.x = left + width / 2.0;
+	double childLeft = left + (width - childrenWidth) / 2.0;
+	for (vector<string>::const_iterator it = placed.begin(); it != placed.end(); ++it) {
+		place(*it, childLeft, depth + 1, subtreeWidths, result);
+		childLeft += subtreeWidths.find(*it)->second + horizontalGap;
+	}
+	result[name].x = (result[placed.front()].x + result[placed.back()].x) / 2.0;
+}
+
+map<string, TreeLayout::Node> TreeLayout::compute() const {
+	map<string, Node> result;
+	map<string, double> subtreeWidths;
+	set<string> visiting;
+
+	// roots first, then frames that are only reachable through a cycle
+	vector<string> starts;
+	map<string, vector<string> >::const_iterator it;
+	for (it = children.begin(); it != children.end(); ++it) {
+		if (parents.find(it->first) == parents.end()) {
+			starts.push_back(it->first);
+		}
+	}
+	for (it = children.begin(); it != children.end(); ++it) {
+		if (parents.find(it->first) != parents.end()) {
+			starts.push_back(it->first);
+		}
+	}
+
+	double left = 0.0;
+	unsigned int maxDepth = 0;
+	for (vector<string>::const_iterator s = starts.begin(); s != starts.end(); ++s) {
+		if (result.find(*s) != result.end()) {
+			continue;
+		}
+		double width = subtreeWidth(*s, subtreeWidths, visiting);
+		place(*s, left, 0, subtreeWidths, result);
+		left += width + horizontalGap;
+	}
+	for (map<string, Node>::const_iterator n = result.begin(); n != result.end(); ++n) {
+		maxDepth = max(maxDepth, n->second.depth);
+	}
+
+	totalWidth = result.empty() ? 0.0 : left - horizontalGap;
+	totalHeight = result.empty() ? 0.0 : maxDepth * layerHeight;
+	return result;
+}
+
+double TreeLayout::width() const {
+	return totalWidth;
+}
+
+double TreeLayout::height() const {
+	return totalHeight;
+}
+
+}  // namespace rct
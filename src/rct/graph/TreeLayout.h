@@ -0,0 +1,72 @@
+/*
+ * TreeLayout.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: lziegler
+ */
+
+#pragma once
+
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace rct {
+
+/**
+ * Layered layout of a frame tree. Every frame is placed on the layer of its
+ * depth, subtrees occupy disjoint horizontal ranges and parents are centered
+ * above their children. Frames with several parents are placed below the
+ * first one, so the layout also copes with graphs that are not trees.
+ */
+class TreeLayout {
+public:
+	class Node {
+	public:
+		Node() :
+				x(0.0), y(0.0), width(0.0), depth(0) {
+		}
+		std::string name;
+		/** center of the node */
+		double x;
+		double y;
+		double width;
+		unsigned int depth;
+	};
+
+	TreeLayout(double horizontalGap = 20.0, double layerHeight = 100.0);
+	virtual ~TreeLayout();
+
+	void setNodeWidth(const std::string& name, double width);
+	void addEdge(const std::string& parent, const std::string& child);
+	void clear();
+
+	/**
+	 * Positions of all frames, keyed by frame name.
+	 */
+	std::map<std::string, Node> compute() const;
+
+	/**
+	 * Total width and height of the last computed layout.
+	 */
+	double width() const;
+	double height() const;
+
+private:
+	double nodeWidth(const std::string& name) const;
+	double subtreeWidth(const std::string& name, std::map<std::string, double>& cache,
+			std::set<std::string>& visiting) const;
+	void place(const std::string& name, double left, unsigned int depth,
+			const std::map<std::string, double>& widths, std::map<std::string, Node>& result) const;
+
+	double horizontalGap;
+	double layerHeight;
+	std::map<std::string, double> widths;
+	std::map<std::string, std::vector<std::string> > children;
+	std::map<std::string, std::string> parents;
+	mutable double totalWidth;
+	mutable double totalHeight;
+};
+
+}  // namespace rct
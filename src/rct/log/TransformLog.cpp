@@ -0,0 +1,418 @@
+/*
+ * TransformLog.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: lziegler
+ */
+
+#include "TransformLog.h"
+#include "../util/Clock.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <map>
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace std;
+
+namespace rct {
+
+const boost::uint64_t TransformLogWriter::INDEX_INTERVAL = 1000000000ull;
+
+rsc::logging::LoggerPtr TransformLogWriter::logger = rsc::logging::Logger::getLogger(
+		"rct.TransformLogWriter");
+rsc::logging::LoggerPtr TransformLogReader::logger = rsc::logging::Logger::getLogger(
+		"rct.TransformLogReader");
+
+namespace {
+
+const char LOG_MAGIC[8] = { 'R', 'C', 'T', 'L', 'O', 'G', 0, 0 };
+const char TRAILER_MAGIC[8] = { 'R', 'C', 'T', 'I', 'D', 'X', 0, 0 };
+const boost::uint32_t VERSION = 2;
+const boost::uint32_t BYTE_ORDER_MARK = 0x01020304;
+
+const boost::uint8_t NAME_RECORD = 1;
+const boost::uint8_t TRANSFORM_RECORD = 2;
+
+struct FileHeader {
+	char magic[8];
+	boost::uint32_t version;
+	boost::uint32_t byteOrder;
+	/** wall clock time of receipt 0 in microseconds since the epoch */
+	boost::int64_t wallStart;
+};
+
+/** at the very end of a complete log */
+struct Footer {
+	boost::uint64_t trailerOffset;
+	boost::uint64_t records;
+	char magic[8];
+};
+
+/** tag, flags, parent, child, authority, stamp, receipt, translation, rotation */
+const size_t TRANSFORM_RECORD_SIZE = 2 + 3 * sizeof(boost::uint32_t) + sizeof(boost::int64_t)
+		+ sizeof(boost::uint64_t) + 7 * sizeof(double);
+
+template<typename T>
+T readValue(const char*& position) {
+	T value;
+	memcpy(&value, position, sizeof(T));
+	position += sizeof(T);
+	return value;
+}
+
+const boost::posix_time::ptime& epoch() {
+	static const boost::posix_time::ptime epoch(boost::gregorian::date(1970, 1, 1));
+	return epoch;
+}
+
+}  // namespace
+
+TransformLogWriter::TransformLogWriter(const string& file) :
+		out(fopen(file.c_str(), "wb")), start(monotonicNanos()), offset(0), records(0) {
+	if (!out) {
+		throw runtime_error("cannot write " + file + ": " + strerror(errno));
+	}
+	setvbuf(out, 0, _IOFBF, 1 << 20);
+
+	FileHeader header;
+	memcpy(header.magic, LOG_MAGIC, sizeof(header.magic));
+	header.version = VERSION;
+	header.byteOrder = BYTE_ORDER_MARK;
+	header.wallStart = (boost::posix_time::microsec_clock::universal_time() - epoch())
+			.total_microseconds();
+	write(&header, sizeof(header));
+}
+
+TransformLogWriter::~TransformLogWriter() {
+	close();
+}
+
+void TransformLogWriter::write(const void* data, size_t size) {
+	if (fwrite(data, 1, size, out) != size) {
+		throw runtime_error(string("cannot write transform log: ") + strerror(errno));
+	}
+	offset += size;
+}
+
+boost::uint32_t TransformLogWriter::intern(const string& name) {
+	boost::uint32_t id;
+	if (names.find(name, id)) {
+		return id;
+	}
+	id = names.intern(name);
+	boost::uint16_t length = min(name.size(), size_t(0xffff));
+
+	write(&NAME_RECORD, sizeof(NAME_RECORD));
+	write(&id, sizeof(id));
+	write(&length, sizeof(length));
+	write(name.data(), length);
+	return id;
+}
+
+void TransformLogWriter::newTransformAvailable(const Transform& transform, bool isStatic) {
+	boost::uint64_t receipt = monotonicNanos() - start;
+	boost::int64_t stamp = (transform.getTime() - epoch()).total_microseconds();
+	Eigen::Vector3d p = transform.getTranslation();
+	Eigen::Quaterniond q = transform.getRotationQuat();
+	double pose[7] = { p.x(), p.y(), p.z(), q.w(), q.x(), q.y(), q.z() };
+
+	boost::mutex::scoped_lock lock(mutex);
+	if (!out) {
+		return;
+	}
+	try {
+		boost::uint32_t parent = intern(transform.getFrameParent());
+		boost::uint32_t child = intern(transform.getFrameChild());
+		boost::uint32_t authority = intern(transform.getAuthority());
+
+		if (index.empty() || receipt - index.back().first >= INDEX_INTERVAL) {
+			index.push_back(make_pair(receipt, offset));
+		}
+		char record[TRANSFORM_RECORD_SIZE];
+		char* position = record;
+		*position++ = TRANSFORM_RECORD;
+		*position++ = isStatic ? 1 : 0;
+		memcpy(position, &parent, sizeof(parent));
+		position += sizeof(parent);
+		memcpy(position, &child, sizeof(child));
+		position += sizeof(child);
+		memcpy(position, &authority, sizeof(authority));
+		position += sizeof(authority);
+		memcpy(position, &stamp, sizeof(stamp));
+		position += sizeof(stamp);
+		memcpy(position, &receipt, sizeof(receipt));
+		position += sizeof(receipt);
+		memcpy(position, pose, sizeof(pose));
+		write(record, sizeof(record));
+		records++;
+	} catch (std::exception& e) {
+		RSCERROR(logger, e.what() << ", recording stopped");
+		fclose(out);
+		out = 0;
+	}
+}
+
+void TransformLogWriter::close() {
+	boost::mutex::scoped_lock lock(mutex);
+	if (!out) {
+		return;
+	}
+	try {
+		Footer footer;
+		footer.trailerOffset = offset;
+		footer.records = records;
+		memcpy(footer.magic, TRAILER_MAGIC, sizeof(footer.magic));
+
+		boost::uint32_t nameCount = names.size();
+		write(&nameCount, sizeof(nameCount));
+		for (boost::uint32_t id = 0; id < nameCount; ++id) {
+			const string& name = names.name(id);
+			boost::uint16_t length = min(name.size(), size_t(0xffff));
+			write(&length, sizeof(length));
+			write(name.data(), length);
+		}
+		boost::uint64_t indexCount = index.size();
+		write(&indexCount, sizeof(indexCount));
+		vector<pair<boost::uint64_t, boost::uint64_t> >::iterator iIt;
+		for (iIt = index.begin(); iIt != index.end(); ++iIt) {
+			write(&iIt->first, sizeof(iIt->first));
+			write(&iIt->second, sizeof(iIt->second));
+		}
+		write(&footer, sizeof(footer));
+	} catch (std::exception& e) {
+		RSCERROR(logger, e.what());
+	}
+	fclose(out);
+	out = 0;
+}
+
+unsigned long TransformLogWriter::recordCount() const {
+	boost::mutex::scoped_lock lock(mutex);
+	return records;
+}
+
+unsigned long TransformLogWriter::byteCount() const {
+	boost::mutex::scoped_lock lock(mutex);
+	return offset;
+}
+
+TransformLogReader::TransformLogReader(const string& file) :
+		data(0), size(0), end(0), position(0), hasTrailer(false), records(0) {
+	int fd = open(file.c_str(), O_RDONLY);
+	if (fd < 0) {
+		throw runtime_error("cannot read " + file + ": " + strerror(errno));
+	}
+	struct stat st;
+	if (fstat(fd, &st) != 0 || size_t(st.st_size) < sizeof(FileHeader)) {
+		::close(fd);
+		throw runtime_error(file + " is not a transform log");
+	}
+	size = st.st_size;
+	void* memory = mmap(0, size, PROT_READ, MAP_PRIVATE, fd, 0);
+	::close(fd);
+	if (memory == MAP_FAILED) {
+		throw runtime_error("cannot map " + file + ": " + strerror(errno));
+	}
+	data = static_cast<const char*>(memory);
+	madvise(memory, size, MADV_SEQUENTIAL);
+
+	const char* p = data;
+	FileHeader header = readValue<FileHeader>(p);
+	if (memcmp(header.magic, LOG_MAGIC, sizeof(header.magic)) != 0
+			|| header.version != VERSION || header.byteOrder != BYTE_ORDER_MARK) {
+		munmap(memory, size);
+		throw runtime_error(file + " is not a transform log of this version and byte order");
+	}
+	wallStart = epoch() + boost::posix_time::microseconds(header.wallStart);
+	end = data + size;
+	try {
+		readTrailer();
+	} catch (std::exception& e) {
+		RSCWARN(logger, file << ": " << e.what() << ", reading without index");
+		hasTrailer = false;
+		end = data + size;
+		nameTable.clear();
+		index.clear();
+	}
+	if (!hasTrailer) {
+		RSCINFO(logger, file << " has no index, it was probably not closed");
+	}
+	rewind();
+}
+
+TransformLogReader::~TransformLogReader() {
+	munmap(const_cast<char*>(data), size);
+}
+
+void TransformLogReader::readTrailer() {
+	if (size < sizeof(FileHeader) + sizeof(Footer)) {
+		return;
+	}
+	const char* p = data + size - sizeof(Footer);
+	Footer footer = readValue<Footer>(p);
+	if (memcmp(footer.magic, TRAILER_MAGIC, sizeof(footer.magic)) != 0) {
+		return;
+	}
+	if (footer.trailerOffset < sizeof(FileHeader)
+			|| footer.trailerOffset > size - sizeof(Footer)) {
+		throw runtime_error("corrupt trailer");
+	}
+	const char* trailerEnd = data + size - sizeof(Footer);
+	p = data + footer.trailerOffset;
+
+	if (p + sizeof(boost::uint32_t) > trailerEnd) {
+		throw runtime_error("corrupt name table");
+	}
+	boost::uint32_t nameCount = readValue<boost::uint32_t>(p);
+	for (boost::uint32_t i = 0; i < nameCount; ++i) {
+		if (p + sizeof(boost::uint16_t) > trailerEnd) {
+			throw runtime_error("corrupt name table");
+		}
+		boost::uint16_t length = readValue<boost::uint16_t>(p);
+		if (p + length > trailerEnd) {
+			throw runtime_error("corrupt name table");
+		}
+		nameTable.push_back(string(p, length));
+		p += length;
+	}
+	if (p + sizeof(boost::uint64_t) > trailerEnd) {
+		throw runtime_error("corrupt index");
+	}
+	boost::uint64_t indexCount = readValue<boost::uint64_t>(p);
+	if (indexCount > size_t(trailerEnd - p) / (2 * sizeof(boost::uint64_t))) {
+		throw runtime_error("corrupt index");
+	}
+	for (boost::uint64_t i = 0; i < indexCount; ++i) {
+		boost::uint64_t receipt = readValue<boost::uint64_t>(p);
+		boost::uint64_t offset = readValue<boost::uint64_t>(p);
+		if (offset < sizeof(FileHeader) || offset >= footer.trailerOffset) {
+			throw runtime_error("corrupt index");
+		}
+		index.push_back(make_pair(receipt, offset));
+	}
+	end = data + footer.trailerOffset;
+	records = footer.records;
+	hasTrailer = true;
+}
+
+bool TransformLogReader::next(TransformLogRecord& record) {
+	while (position < end) {
+		const char* p = position;
+		boost::uint8_t tag = readValue<boost::uint8_t>(p);
+		if (tag == NAME_RECORD) {
+			if (end - p < ptrdiff_t(sizeof(boost::uint32_t) + sizeof(boost::uint16_t))) {
+				break;
+			}
+			boost::uint32_t id = readValue<boost::uint32_t>(p);
+			boost::uint16_t length = readValue<boost::uint16_t>(p);
+			if (end - p < length) {
+				break;
+			}
+			if (id >= nameTable.size()) {
+				nameTable.resize(id + 1);
+			}
+			nameTable[id] = string(p, length);
+			position = p + length;
+			continue;
+		}
+		if (tag != TRANSFORM_RECORD) {
+			RSCWARN(logger, "unknown record type " << int(tag) << ", stopping");
+			break;
+		}
+		if (end - position < ptrdiff_t(TRANSFORM_RECORD_SIZE)) {
+			// cut off at the end of an unclosed log
+			break;
+		}
+		bool isStatic = readValue<boost::uint8_t>(p) != 0;
+		boost::uint32_t parent = readValue<boost::uint32_t>(p);
+		boost::uint32_t child = readValue<boost::uint32_t>(p);
+		boost::uint32_t authority = readValue<boost::uint32_t>(p);
+		boost::int64_t stamp = readValue<boost::int64_t>(p);
+		boost::uint64_t receipt = readValue<boost::uint64_t>(p);
+		double pose[7];
+		memcpy(pose, p, sizeof(pose));
+		position = p + sizeof(pose);
+
+		if (parent >= nameTable.size() || child >= nameTable.size()
+				|| authority >= nameTable.size()) {
+			RSCWARN(logger, "record refers to an unknown name, skipping");
+			continue;
+		}
+		Eigen::Vector3d translation(pose[0], pose[1], pose[2]);
+		Eigen::Quaterniond rotation(pose[3], pose[4], pose[5], pose[6]);
+		Eigen::Affine3d affine = Eigen::Affine3d().fromPositionOrientationScale(translation,
+				rotation, Eigen::Vector3d::Ones());
+		record.transform = Transform(affine, nameTable[parent], nameTable[child],
+				epoch() + boost::posix_time::microseconds(stamp));
+		record.transform.setAuthority(nameTable[authority]);
+		record.isStatic = isStatic;
+		record.receipt = receipt;
+		return true;
+	}
+	position = end;
+	return false;
+}
+
+void TransformLogReader::seek(boost::uint64_t receipt) {
+	rewind();
+	if (!index.empty()) {
+		// last index entry at or before the requested time
+		vector<pair<boost::uint64_t, boost::uint64_t> >::iterator it = upper_bound(index.begin(),
+				index.end(), make_pair(receipt, boost::uint64_t(-1)));
+		if (it != index.begin()) {
+			--it;
+			position = data + it->second;
+		}
+	}
+	TransformLogRecord record;
+	const char* before = position;
+	while (next(record)) {
+		if (record.receipt >= receipt) {
+			position = before;
+			return;
+		}
+		before = position;
+	}
+}
+
+vector<TransformLogRecord> TransformLogReader::staticsBefore(boost::uint64_t receipt) {
+	rewind();
+	map<string, TransformLogRecord> latest;
+	TransformLogRecord record;
+	while (next(record) && record.receipt < receipt) {
+		if (record.isStatic) {
+			latest[record.transform.getFrameChild()] = record;
+		}
+	}
+	rewind();
+	vector<TransformLogRecord> result;
+	map<string, TransformLogRecord>::const_iterator it;
+	for (it = latest.begin(); it != latest.end(); ++it) {
+		result.push_back(it->second);
+	}
+	return result;
+}
+
+boost::posix_time::ptime TransformLogReader::recordingStart() const {
+	return wallStart;
+}
+
+void TransformLogReader::rewind() {
+	position = data + sizeof(FileHeader);
+}
+
+bool TransformLogReader::complete() const {
+	return hasTrailer;
+}
+
+unsigned long TransformLogReader::recordCount() const {
+	return records;
+}
+
+}  // namespace rct
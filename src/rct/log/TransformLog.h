@@ -0,0 +1,160 @@
+/*
+ * TransformLog.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: lziegler
+ */
+
+#pragma once
+
+#include "../util/NameInterner.h"
+
+#include <rct/TransformListener.h>
+#include <rsc/logging/Logger.h>
+
+#include <boost/cstdint.hpp>
+#include <boost/thread/mutex.hpp>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace rct {
+
+/**
+ * One transform of a log together with the time it was received, in
+ * nanoseconds since the start of the recording.
+ */
+class TransformLogRecord {
+public:
+	TransformLogRecord() :
+			isStatic(false), receipt(0) {
+	}
+	Transform transform;
+	bool isStatic;
+	boost::uint64_t receipt;
+};
+
+/**
+ * Appends every transform it is notified of to a binary log file.
+ *
+ * The log is a header followed by records. Frame and authority names are
+ * interned: a name record assigns an id on first use and transform records
+ * refer to it. Transforms are stored with stamp, receipt time, authority and
+ * static flag. close() appends a trailer with the name table and a time
+ * index, one entry per INDEX_INTERVAL of receipt time, so that a reader can
+ * map the file and seek. A log without trailer, e.g. after a crash, is still
+ * readable from the start.
+ *
+ * The log is written in host byte order.
+ */
+class TransformLogWriter: public TransformListener {
+public:
+	typedef boost::shared_ptr<TransformLogWriter> Ptr;
+
+	/** receipt time between two index entries in nanoseconds */
+	static const boost::uint64_t INDEX_INTERVAL;
+
+	/**
+	 * Creates or truncates the file. Throws std::runtime_error if it cannot
+	 * be opened.
+	 */
+	TransformLogWriter(const std::string& file);
+	virtual ~TransformLogWriter();
+
+	void newTransformAvailable(const Transform& transform, bool isStatic);
+
+	/**
+	 * Writes the trailer and closes the file. Called by the destructor if
+	 * needed. Later transforms are ignored.
+	 */
+	void close();
+
+	unsigned long recordCount() const;
+	unsigned long byteCount() const;
+
+private:
+	boost::uint32_t intern(const std::string& name);
+	void write(const void* data, size_t size);
+
+	mutable boost::mutex mutex;
+	FILE* out;
+	boost::uint64_t start;
+	boost::uint64_t offset;
+	unsigned long records;
+	NameInterner names;
+	std::vector<std::pair<boost::uint64_t, boost::uint64_t> > index;
+
+	static rsc::logging::LoggerPtr logger;
+};
+
+/**
+ * Reads a log written by TransformLogWriter through a read-only mapping.
+ */
+class TransformLogReader {
+public:
+	typedef boost::shared_ptr<TransformLogReader> Ptr;
+
+	/**
+	 * Maps the file. Throws std::runtime_error if it cannot be read or is not
+	 * a transform log.
+	 */
+	TransformLogReader(const std::string& file);
+	virtual ~TransformLogReader();
+
+	/**
+	 * Reads the record at the current position and advances. Returns false at
+	 * the end of the log.
+	 */
+	bool next(TransformLogRecord& record);
+
+	/**
+	 * Continues at the first record received at or after the given time
+	 * (nanoseconds since the start of the recording).
+	 */
+	void seek(boost::uint64_t receipt);
+
+	/**
+	 * The latest static transform of every child frame received before the
+	 * given time, which a replay starting there has to send first. Scans the
+	 * log from the start and rewinds.
+	 */
+	std::vector<TransformLogRecord> staticsBefore(boost::uint64_t receipt);
+
+	/**
+	 * Continues at the first record.
+	 */
+	void rewind();
+
+	/**
+	 * Wall clock time of receipt 0, i.e. when the recording started.
+	 */
+	boost::posix_time::ptime recordingStart() const;
+
+	/**
+	 * True if the log has a trailer. Otherwise seek() scans from the start.
+	 */
+	bool complete() const;
+
+	/**
+	 * Number of transform records, only known for complete logs.
+	 */
+	unsigned long recordCount() const;
+
+private:
+	void readTrailer();
+
+	const char* data;
+	size_t size;
+	/** end of the record section */
+	const char* end;
+	const char* position;
+	bool hasTrailer;
+	unsigned long records;
+	boost::posix_time::ptime wallStart;
+	std::vector<std::string> nameTable;
+	std::vector<std::pair<boost::uint64_t, boost::uint64_t> > index;
+
+	static rsc::logging::LoggerPtr logger;
+};
+
+}  // namespace rct
@@ -0,0 +1,145 @@
+/*
+ * EdgeMonitor.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: lziegler
+ */
+
+#include "EdgeMonitor.h"
+#include "../util/Clock.h"
+
+#include <algorithm>
+#include <cmath>
+#include <unistd.h>
+
+using namespace std;
+
+namespace rct {
+
+rsc::logging::LoggerPtr EdgeMonitor::logger = rsc::logging::Logger::getLogger("rct.EdgeMonitor");
+
+EdgeInfo::EdgeInfo() :
+		isStatic(false), updates(0), lastReceipt(0), meanInterval(0.0), jitter(0.0),
+				meanDelay(0.0), maxDelay(0.0) {
+}
+
+double EdgeInfo::rate() const {
+	return meanInterval > 0.0 ? 1.0 / meanInterval : 0.0;
+}
+
+double EdgeInfo::age(boost::uint64_t now) const {
+	return now > lastReceipt ? (now - lastReceipt) / 1000000000.0 : 0.0;
+}
+
+EdgeMonitor::EdgeMonitor(double smoothing) :
+		version(0), smoothing(smoothing) {
+}
+
+EdgeMonitor::~EdgeMonitor() {
+}
+
+void EdgeMonitor::newTransformAvailable(const Transform& transform, bool isStatic) {
+	boost::uint64_t now = monotonicNanos();
+	boost::posix_time::ptime wallNow = boost::posix_time::microsec_clock::universal_time();
+	double delay = (wallNow - transform.getTime()).total_microseconds() / 1000000.0;
+
+	boost::mutex::scoped_lock lock(mutex);
+	EdgeInfo& edge = edges[make_pair(transform.getFrameParent(), transform.getFrameChild())];
+
+	if (edge.updates == 0) {
+		edge.parent = transform.getFrameParent();
+		edge.child = transform.getFrameChild();
+		edge.meanDelay = delay;
+		version++;
+		RSCDEBUG(logger, "new edge " << edge.parent << " -> " << edge.child);
+	} else {
+		double interval = (now - edge.lastReceipt) / 1000000000.0;
+		if (edge.updates == 1) {
+			edge.meanInterval = interval;
+		} else {
+			double deviation = interval - edge.meanInterval;
+			edge.meanInterval += smoothing * deviation;
+			double variance = (1.0 - smoothing)
+					* (edge.jitter * edge.jitter + smoothing * deviation * deviation);
+			edge.jitter = sqrt(variance);
+		}
+		edge.meanDelay += smoothing * (delay - edge.meanDelay);
+	}
+	if (edge.authority != transform.getAuthority() || edge.isStatic != isStatic) {
+		edge.authority = transform.getAuthority();
+		edge.isStatic = isStatic;
+		version++;
+	}
+	edge.maxDelay = max(edge.maxDelay, delay);
+	edge.lastStamp = transform.getTime();
+	edge.lastReceipt = now;
+	edge.updates++;
+}
+
+vector<EdgeInfo> EdgeMonitor::snapshot() const {
+	boost::mutex::scoped_lock lock(mutex);
+	vector<EdgeInfo> result;
+	result.reserve(edges.size());
+	for (EdgeMap::const_iterator it = edges.begin(); it != edges.end(); ++it) {
+		result.push_back(it->second);
+	}
+	return result;
+}
+
+size_t EdgeMonitor::edgeCount() const {
+	boost::mutex::scoped_lock lock(mutex);
+	return edges.size();
+}
+
+unsigned long EdgeMonitor::structureVersion() const {
+	boost::mutex::scoped_lock lock(mutex);
+	return version;
+}
+
+bool EdgeMonitor::waitForStableStructure(double quietPeriod, double timeout) const {
+	boost::uint64_t start = monotonicNanos();
+	boost::uint64_t deadline = start + boost::uint64_t(timeout * 1000000000.0);
+	boost::uint64_t quiet = boost::uint64_t(quietPeriod * 1000000000.0);
+	useconds_t poll = useconds_t(min(max(quietPeriod / 4.0, 0.005), 0.05) * 1000000.0);
+
+	unsigned long lastVersion = structureVersion();
+	boost::uint64_t lastChange = start;
+	while (true) {
+		boost::uint64_t now = monotonicNanos();
+		unsigned long currentVersion = structureVersion();
+		if (currentVersion != lastVersion) {
+			lastVersion = currentVersion;
+			lastChange = now;
+		} else if (edgeCount() > 0 && now - lastChange >= quiet) {
+			RSCDEBUG(logger, "structure stable after " << nanosToMillis(now - start) << " ms");
+			return true;
+		}
+		if (now >= deadline) {
+			return false;
+		}
+		usleep(poll);
+	}
+}
+
+void EdgeMonitor::resetMaxima() {
+	boost::mutex::scoped_lock lock(mutex);
+	for (EdgeMap::iterator it = edges.begin(); it != edges.end(); ++it) {
+		it->second.maxDelay = it->second.meanDelay;
+	}
+}
+
+bool EdgeMonitor::isStale(const EdgeInfo& edge, boost::uint64_t now, double staleFactor,
+		double timeout, double firstInterval) {
+	if (edge.isStatic) {
+		return false;
+	}
+	double age = edge.age(now);
+	if (timeout > 0.0 && age > timeout) {
+		return true;
+	}
+	// the interval is only known from the second update on
+	double interval = edge.meanInterval > 0.0 ? edge.meanInterval : firstInterval;
+	return staleFactor > 0.0 && age > staleFactor * interval;
+}
+
+}  // namespace rct
@@ -0,0 +1,114 @@
+/*
+ * EdgeMonitor.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: lziegler
+ */
+
+#pragma once
+
+#include <rct/TransformListener.h>
+#include <rsc/logging/Logger.h>
+
+#include <boost/cstdint.hpp>
+#include <boost/thread/mutex.hpp>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace rct {
+
+/**
+ * Statistics of a single parent -> child edge of the transform graph.
+ * Intervals and delays are exponentially weighted moving averages, so they
+ * follow changes of a publisher within a few updates.
+ */
+class EdgeInfo {
+public:
+	EdgeInfo();
+
+	/**
+	 * Updates per second, derived from the mean receipt interval.
+	 */
+	double rate() const;
+
+	/**
+	 * Seconds since the last update at monotonic time now.
+	 */
+	double age(boost::uint64_t now) const;
+
+	std::string parent;
+	std::string child;
+	std::string authority;
+	bool isStatic;
+	unsigned long updates;
+
+	/** stamp of the last transform */
+	boost::posix_time::ptime lastStamp;
+	/** monotonic receipt time of the last transform in nanoseconds */
+	boost::uint64_t lastReceipt;
+
+	/** mean and standard deviation of the receipt interval in seconds */
+	double meanInterval;
+	double jitter;
+	/** mean and maximum delay between stamp and receipt in seconds */
+	double meanDelay;
+	double maxDelay;
+};
+
+/**
+ * Watches all transforms seen by a receiver and keeps per-edge statistics.
+ * Register it as listener when creating the TransformReceiver.
+ */
+class EdgeMonitor: public TransformListener {
+public:
+	typedef boost::shared_ptr<EdgeMonitor> Ptr;
+
+	EdgeMonitor(double smoothing = 0.1);
+	virtual ~EdgeMonitor();
+
+	void newTransformAvailable(const Transform& transform, bool isStatic);
+
+	std::vector<EdgeInfo> snapshot() const;
+	size_t edgeCount() const;
+
+	/**
+	 * Incremented whenever an edge appears or changes its authority or its
+	 * static flag. Stays constant while the graph structure is stable.
+	 */
+	unsigned long structureVersion() const;
+
+	/**
+	 * Blocks until at least one edge is known and the structure did not change
+	 * for quietPeriod seconds, but at most for timeout seconds. Returns true if
+	 * the structure settled before the timeout.
+	 */
+	bool waitForStableStructure(double quietPeriod, double timeout) const;
+
+	/**
+	 * Resets the maximum delay of all edges.
+	 */
+	void resetMaxima();
+
+	/**
+	 * A dynamic edge is stale if it was not updated for staleFactor times its
+	 * mean interval, or for timeout seconds if timeout is positive, whichever
+	 * comes first. Until its second update the mean interval of an edge is
+	 * taken to be firstInterval seconds, so that an edge that stops after its
+	 * first update turns stale as well.
+	 */
+	static bool isStale(const EdgeInfo& edge, boost::uint64_t now, double staleFactor,
+			double timeout = 0.0, double firstInterval = 1.0);
+
+private:
+	typedef std::map<std::pair<std::string, std::string>, EdgeInfo> EdgeMap;
+
+	mutable boost::mutex mutex;
+	EdgeMap edges;
+	unsigned long version;
+	double smoothing;
+
+	static rsc::logging::LoggerPtr logger;
+};
+
+}  // namespace rct
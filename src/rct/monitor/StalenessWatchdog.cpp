@@ -0,0 +1,132 @@
+/*
+ * StalenessWatchdog.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: lziegler
+ */
+
+#include "StalenessWatchdog.h"
+#include "../util/Clock.h"
+#include "../util/Probes.h"
+
+#include <algorithm>
+#include <utility>
+
+using namespace std;
+
+namespace rct {
+
+rsc::logging::LoggerPtr StalenessWatchdog::logger = rsc::logging::Logger::getLogger(
+		"rct.StalenessWatchdog");
+
+StalenessWatchdog::StalenessWatchdog(double staleFactor, double timeout, double resolution,
+		double smoothing, double firstInterval) :
+		staleFactor(staleFactor), timeout(timeout), resolution(
+				max(boost::uint64_t(resolution * 1000000000.0), boost::uint64_t(1000000))), smoothing(
+				smoothing), firstInterval(firstInterval), wheel(toTick(monotonicNanos())), stale(0), stopped(false) {
+	checker = boost::thread(&StalenessWatchdog::run, this);
+}
+
+StalenessWatchdog::~StalenessWatchdog() {
+	stop();
+}
+
+boost::uint64_t StalenessWatchdog::toTick(boost::uint64_t nanos) const {
+	return nanos / resolution;
+}
+
+void StalenessWatchdog::update(const string& name) {
+	boost::uint64_t now = monotonicNanos();
+	boost::mutex::scoped_lock lock(mutex);
+	TimerWheel::Id id = names.intern(name);
+	if (id == edges.size()) {
+		edges.push_back(Edge());
+	}
+	Edge& edge = edges[id];
+
+	if (edge.updates > 0) {
+		double interval = (now - edge.lastReceipt) / 1000000000.0;
+		if (edge.updates == 1) {
+			edge.meanInterval = interval;
+		} else {
+			edge.meanInterval += smoothing * (interval - edge.meanInterval);
+		}
+	}
+	if (edge.stale) {
+		edge.stale = false;
+		stale--;
+		RSCINFO(logger,
+				"edge " << name << " recovered after " << (now - edge.lastReceipt) / 1000000000.0 << " s");
+	}
+	edge.lastReceipt = now;
+	edge.updates++;
+
+	// the interval is only known from the second update on
+	double interval = edge.meanInterval > 0.0 ? edge.meanInterval : firstInterval;
+	double limit = staleFactor > 0.0 ? staleFactor * interval : 0.0;
+	if (timeout > 0.0 && (limit <= 0.0 || timeout < limit)) {
+		limit = timeout;
+	}
+	if (limit > 0.0) {
+		wheel.schedule(id, toTick(now + boost::uint64_t(limit * 1000000000.0)) + 1);
+	}
+}
+
+void StalenessWatchdog::stop() {
+	{
+		boost::mutex::scoped_lock lock(mutex);
+		if (stopped) {
+			return;
+		}
+		stopped = true;
+		cond.notify_all();
+	}
+	checker.join();
+}
+
+size_t StalenessWatchdog::edgeCount() const {
+	boost::mutex::scoped_lock lock(mutex);
+	return edges.size();
+}
+
+size_t StalenessWatchdog::staleCount() const {
+	boost::mutex::scoped_lock lock(mutex);
+	return stale;
+}
+
+void StalenessWatchdog::run() {
+	boost::posix_time::time_duration period = boost::posix_time::microseconds(
+			resolution / 1000);
+	vector<TimerWheel::Id> expired;
+	vector<pair<const string*, double> > reports;
+	boost::mutex::scoped_lock lock(mutex);
+	while (!stopped) {
+		cond.timed_wait(lock, period);
+		boost::uint64_t now = monotonicNanos();
+		expired.clear();
+		wheel.advance(toTick(now), expired);
+		if (expired.empty()) {
+			continue;
+		}
+		reports.clear();
+		vector<TimerWheel::Id>::const_iterator it;
+		for (it = expired.begin(); it != expired.end(); ++it) {
+			Edge& edge = edges[*it];
+			edge.stale = true;
+			stale++;
+			// names are never removed, so the reference outlives the lock
+			reports.push_back(
+					make_pair(&names.name(*it), (now - edge.lastReceipt) / 1000000000.0));
+		}
+		lock.unlock();
+		vector<pair<const string*, double> >::const_iterator rIt;
+		for (rIt = reports.begin(); rIt != reports.end(); ++rIt) {
+			RCT_PROBE2(rct_watchdog, stale, rIt->first->c_str(),
+					boost::uint64_t(rIt->second * 1000.0));
+			RSCWARN(logger, "edge " << *rIt->first << " stale, no update for " << rIt->second << " s");
+		}
+		lock.lock();
+	}
+}
+
+}  // namespace rct
@@ -0,0 +1,82 @@
+/*
+ * StalenessWatchdog.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: lziegler
+ */
+
+#pragma once
+
+#include "../util/NameInterner.h"
+#include "../util/TimerWheel.h"
+
+#include <rsc/logging/Logger.h>
+
+#include <boost/cstdint.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/thread.hpp>
+#include <string>
+#include <vector>
+
+namespace rct {
+
+/**
+ * Reports dynamic edges that stop updating, with the same criterion as
+ * EdgeMonitor::isStale(): an edge is stale if it was not updated for
+ * staleFactor times its mean interval, or for timeout seconds if timeout is
+ * positive, whichever comes first. Until the second update of an edge its
+ * mean interval is taken to be firstInterval seconds.
+ *
+ * Every update() reschedules the deadline of its edge in a TimerWheel, so the
+ * cost per transform is constant and a single thread checks all edges once
+ * per resolution. An edge is reported once when it becomes stale and again
+ * when it recovers. Edges are identified by name, usually the child frame.
+ */
+class StalenessWatchdog {
+public:
+	typedef boost::shared_ptr<StalenessWatchdog> Ptr;
+
+	StalenessWatchdog(double staleFactor, double timeout = 0.0, double resolution = 0.01,
+			double smoothing = 0.1, double firstInterval = 1.0);
+	virtual ~StalenessWatchdog();
+
+	void update(const std::string& edge);
+
+	void stop();
+
+	size_t edgeCount() const;
+	size_t staleCount() const;
+
+private:
+	struct Edge {
+		Edge() :
+				updates(0), lastReceipt(0), meanInterval(0.0), stale(false) {
+		}
+		unsigned long updates;
+		boost::uint64_t lastReceipt;
+		double meanInterval;
+		bool stale;
+	};
+
+	boost::uint64_t toTick(boost::uint64_t nanos) const;
+	void run();
+
+	double staleFactor;
+	double timeout;
+	boost::uint64_t resolution;
+	double smoothing;
+	double firstInterval;
+
+	NameInterner names;
+	std::vector<Edge> edges;
+	TimerWheel wheel;
+	size_t stale;
+	bool stopped;
+	mutable boost::mutex mutex;
+	boost::condition_variable cond;
+	boost::thread checker;
+
+	static rsc::logging::LoggerPtr logger;
+};
+
+}  // namespace rct
@@ -6,6 +6,7 @@
  */
 
 #include "ParserINI.h"
+#include "../util/Probes.h"
 
 #include <boost/property_tree/ptree.hpp>
 #include <boost/property_tree/ini_parser.hpp>
@@ -42,6 +43,7 @@ bool ParserINI::canParse(const string& file) {
 
 vector<string>  ParserINI::parseConvertScopes(const string& file) {
 	ptree pt;
+	RCT_PROBE1(rct_parser, parse_begin, file.c_str());
 	ini_parser::read_ini(file, pt);
 
 	RSCDEBUG(logger, "parse: " << file);
@@ -54,11 +56,13 @@ vector<string>  ParserINI::parseConvertScopes(const string& file) {
 		}
 	}
 
+	RCT_PROBE2(rct_parser, parse_end, file.c_str(), scopes.size());
 	return scopes;
 }
 
 ParserResultTransforms ParserINI::parseStaticTransforms(const string& file) {
 	ptree pt;
+	RCT_PROBE1(rct_parser, parse_begin, file.c_str());
 	ini_parser::read_ini(file, pt);
 
 	RSCDEBUG(logger, "parse: " << file);
@@ -141,6 +145,7 @@ ParserResultTransforms ParserINI::parseStaticTransforms(const string& file) {
 
 	ParserResultTransforms results;
 	results.transforms = transforms;
+	RCT_PROBE2(rct_parser, parse_end, file.c_str(), results.transforms.size());
 	return results;
 }
 
@@ -148,6 +153,7 @@ vector<ParserResultMessage> ParserINI::parseConvertMessages(const string& file)
 
 	vector<ParserResultMessage> messages;
 	ptree pt;
+	RCT_PROBE1(rct_parser, parse_begin, file.c_str());
 	ini_parser::read_ini(file, pt);
 
 	RSCDEBUG(logger, "parse: " << file);
@@ -168,6 +174,7 @@ vector<ParserResultMessage> ParserINI::parseConvertMessages(const string& file)
 		messages.push_back(msg);
 	}
 
+	RCT_PROBE2(rct_parser, parse_end, file.c_str(), messages.size());
 	return messages;
 }
 
@@ -6,6 +6,7 @@
  */
 
 #include "ParserXML.h"
+#include "../util/Probes.h"
 
 #include <boost/property_tree/ptree.hpp>
 #include <boost/property_tree/xml_parser.hpp>
@@ -39,6 +40,7 @@ bool ParserXML::canParse(const string& file) {
 
 vector<string> ParserXML::parseConvertScopes(const string& file) {
 	ptree pt;
+	RCT_PROBE1(rct_parser, parse_begin, file.c_str());
 	xml_parser::read_xml(file, pt);
 
 	RSCDEBUG(logger, "parse: " << file);
@@ -47,10 +49,12 @@ vector<string> ParserXML::parseConvertScopes(const string& file) {
 	BOOST_FOREACH(ptree::value_type const& v, pt.get_child("rct.scopes") ) {
 		scopes.push_back(v.second.data());
 	}
+	RCT_PROBE2(rct_parser, parse_end, file.c_str(), scopes.size());
 	return scopes;
 }
 ParserResultTransforms ParserXML::parseStaticTransforms(const string& file) {
 	ptree pt;
+	RCT_PROBE1(rct_parser, parse_begin, file.c_str());
 	xml_parser::read_xml(file, pt);
 
 	RSCDEBUG(logger, "parse: " << file);
@@ -162,11 +166,13 @@ ParserResultTransforms ParserXML::parseStaticTransforms(const string& file) {
 	ParserResultTransforms results;
 	results.transforms = transforms;
 	results.config = config;
+	RCT_PROBE2(rct_parser, parse_end, file.c_str(), results.transforms.size());
 	return results;
 }
 
 vector<ParserResultMessage> ParserXML::parseConvertMessages(const string& file) {
 	ptree pt;
+	RCT_PROBE1(rct_parser, parse_begin, file.c_str());
 	xml_parser::read_xml(file, pt);
 
 	RSCDEBUG(logger, "parse: " << file);
@@ -183,6 +189,7 @@ vector<ParserResultMessage> ParserXML::parseConvertMessages(const string& file)
 		messages.push_back(msg);
 	}
 
+	RCT_PROBE2(rct_parser, parse_end, file.c_str(), messages.size());
 	return messages;
 }
 
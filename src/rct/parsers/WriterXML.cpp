@@ -0,0 +1,77 @@
+/*
+ * WriterXML.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: lziegler
+ */
+
+#include "WriterXML.h"
+
+#include <boost/property_tree/ptree.hpp>
+#include <boost/property_tree/xml_parser.hpp>
+
+using namespace std;
+using namespace boost::property_tree;
+
+namespace rct {
+
+rsc::logging::LoggerPtr WriterXML::logger = rsc::logging::Logger::getLogger("rct.WriterXML");
+
+WriterXML::WriterXML() {
+}
+
+WriterXML::~WriterXML() {
+}
+
+void WriterXML::writeStaticTransforms(const string& file, const ParserResultTransforms& result) {
+	RSCDEBUG(logger, "write: " << file);
+
+	ptree pt;
+	pt.put("rct.core.cachetime.<xmlattr>.value", result.config.getCacheTime().total_seconds());
+
+	ptree& ptTransforms = pt.put_child("rct.transforms", ptree());
+	vector<Transform>::const_iterator it;
+	for (it = result.transforms.begin(); it != result.transforms.end(); ++it) {
+		Eigen::Vector3d translation = it->getTranslation();
+		Eigen::Quaterniond rotation = it->getRotationQuat();
+
+		ptree ptTransform;
+		ptTransform.put("<xmlattr>.parent", it->getFrameParent());
+		ptTransform.put("<xmlattr>.child", it->getFrameChild());
+		ptTransform.put("translation.<xmlattr>.x", translation.x());
+		ptTransform.put("translation.<xmlattr>.y", translation.y());
+		ptTransform.put("translation.<xmlattr>.z", translation.z());
+		ptTransform.put("translation.<xmlattr>.unit", "METER");
+		ptTransform.put("rotation.<xmlattr>.qw", rotation.w());
+		ptTransform.put("rotation.<xmlattr>.qx", rotation.x());
+		ptTransform.put("rotation.<xmlattr>.qy", rotation.y());
+		ptTransform.put("rotation.<xmlattr>.qz", rotation.z());
+		ptTransform.put("rotation.<xmlattr>.unit", "RADIAN");
+		ptTransforms.add_child("transform", ptTransform);
+	}
+
+	xml_writer_settings<string> settings('\t', 1);
+	xml_parser::write_xml(file, pt, locale(), settings);
+}
+
+void WriterXML::writeConvertMessages(const string& file,
+		const vector<ParserResultMessage>& messages) {
+	RSCDEBUG(logger, "write: " << file);
+
+	ptree pt;
+	ptree& ptMessages = pt.put_child("rct.messages", ptree());
+	vector<ParserResultMessage>::const_iterator it;
+	for (it = messages.begin(); it != messages.end(); ++it) {
+		ptree ptMessage;
+		ptMessage.put("<xmlattr>.parent", it->parent);
+		ptMessage.put("<xmlattr>.child", it->child);
+		ptMessage.put("<xmlattr>.scope", it->scope);
+		ptMessage.put("<xmlattr>.authority", it->authority);
+		ptMessages.add_child("message", ptMessage);
+	}
+
+	xml_writer_settings<string> settings('\t', 1);
+	xml_parser::write_xml(file, pt, locale(), settings);
+}
+
+}  // namespace rct
@@ -0,0 +1,34 @@
+/*
+ * WriterXML.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: lziegler
+ */
+
+#pragma once
+
+#include "Parser.h"
+
+#include <rsc/logging/Logger.h>
+
+namespace rct {
+
+/**
+ * Writes static transforms and message mappings in the format read by
+ * ParserXML.
+ */
+class WriterXML {
+public:
+	typedef boost::shared_ptr<WriterXML> Ptr;
+	WriterXML();
+	virtual ~WriterXML();
+
+	virtual void writeStaticTransforms(const std::string& file, const ParserResultTransforms& result);
+	virtual void writeConvertMessages(const std::string& file,
+			const std::vector<ParserResultMessage>& messages);
+
+private:
+	static rsc::logging::LoggerPtr logger;
+};
+
+}  // namespace rct
@@ -0,0 +1,102 @@
+/*
+ * PointKernels.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: lziegler
+ */
+
+#include "PointKernels.h"
+
+#include <boost/thread.hpp>
+#include <algorithm>
+
+using namespace std;
+
+namespace rct {
+
+namespace {
+
+// points per block, 3 KiB of doubles stay in the L1 cache
+const size_t BLOCK = 128;
+
+template<class Scalar>
+class Worker {
+public:
+	Worker(const typename PointTransforms<Scalar>::Vector& transforms, const vector<PointJob>& jobs, const Scalar* in,
+			Scalar* out) :
+			transforms(transforms), jobs(jobs), in(in), out(out), next(0) {
+	}
+
+	void run() {
+		while (true) {
+			size_t index = __sync_fetch_and_add(&next, 1);
+			if (index >= jobs.size()) {
+				return;
+			}
+			const PointJob& job = jobs[index];
+			transformPoints(transforms[job.transform], in + 3 * job.offset, out + 3 * job.offset,
+					job.count);
+		}
+	}
+
+private:
+	const typename PointTransforms<Scalar>::Vector& transforms;
+	const vector<PointJob>& jobs;
+	const Scalar* in;
+	Scalar* out;
+	size_t next;
+};
+
+}  // namespace
+
+template<class Scalar>
+void transformPoints(const Eigen::Transform<Scalar, 3, Eigen::Affine>& transform, const Scalar* in,
+		Scalar* out, size_t count) {
+	typedef Eigen::Matrix<Scalar, 3, Eigen::Dynamic> Points;
+	const Eigen::Matrix<Scalar, 3, 3> rotation = transform.linear();
+	const Eigen::Matrix<Scalar, 3, 1> translation = transform.translation();
+
+	for (size_t offset = 0; offset < count; offset += BLOCK) {
+		size_t n = min(BLOCK, count - offset);
+		Eigen::Map<const Points> block(in + 3 * offset, 3, n);
+		Eigen::Map<Points> result(out + 3 * offset, 3, n);
+		if (in == out) {
+			// the product must not alias its input
+			result = (rotation * block).colwise() + translation;
+		} else {
+			result.noalias() = (rotation * block).colwise() + translation;
+		}
+	}
+}
+
+template<class Scalar>
+void transformPointsParallel(const typename PointTransforms<Scalar>::Vector& transforms,
+		const vector<PointJob>& jobs, const Scalar* in, Scalar* out, unsigned int threads) {
+	Worker<Scalar> worker(transforms, jobs, in, out);
+	threads = max(1u, min(threads, (unsigned int) jobs.size()));
+
+	boost::thread_group group;
+	for (unsigned int i = 1; i < threads; ++i) {
+		group.add_thread(new boost::thread(&Worker<Scalar>::run, &worker));
+	}
+	worker.run();
+	group.join_all();
+}
+
+void appendPointJobs(vector<PointJob>& jobs, size_t offset, size_t count, size_t transform,
+		size_t maxCount) {
+	for (size_t done = 0; done < count; done += maxCount) {
+		jobs.push_back(PointJob(offset + done, min(maxCount, count - done), transform));
+	}
+}
+
+template void transformPoints<float>(const Eigen::Transform<float, 3, Eigen::Affine>&,
+		const float*, float*, size_t);
+template void transformPoints<double>(const Eigen::Transform<double, 3, Eigen::Affine>&,
+		const double*, double*, size_t);
+template void transformPointsParallel<float>(const PointTransforms<float>::Vector&,
+		const vector<PointJob>&, const float*, float*, unsigned int);
+template void transformPointsParallel<double>(const PointTransforms<double>::Vector&,
+		const vector<PointJob>&, const double*, double*, unsigned int);
+
+}  // namespace rct
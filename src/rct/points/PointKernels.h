@@ -0,0 +1,62 @@
+/*
+ * PointKernels.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: lziegler
+ */
+
+#pragma once
+
+#include <Eigen/Geometry>
+#include <Eigen/StdVector>
+#include <vector>
+
+namespace rct {
+
+/**
+ * A range of points that is transformed with one of several transforms.
+ */
+class PointJob {
+public:
+	PointJob(size_t offset = 0, size_t count = 0, size_t transform = 0) :
+			offset(offset), count(count), transform(transform) {
+	}
+	size_t offset;
+	size_t count;
+	size_t transform;
+};
+
+/**
+ * Container of transforms for transformPointsParallel.
+ */
+template<class Scalar>
+class PointTransforms {
+public:
+	typedef Eigen::Transform<Scalar, 3, Eigen::Affine> Affine;
+	typedef std::vector<Affine, Eigen::aligned_allocator<Affine> > Vector;
+};
+
+/**
+ * Transforms count interleaved x,y,z points from in to out, which may be the
+ * same buffer. The points are processed in cache sized blocks with a fixed
+ * size 3x3 product, which Eigen vectorizes for float and double.
+ */
+template<class Scalar>
+void transformPoints(const Eigen::Transform<Scalar, 3, Eigen::Affine>& transform, const Scalar* in,
+		Scalar* out, size_t count);
+
+/**
+ * Runs the jobs on the given number of threads. Each job transforms its range
+ * of interleaved points with transforms[job.transform].
+ */
+template<class Scalar>
+void transformPointsParallel(const typename PointTransforms<Scalar>::Vector& transforms,
+		const std::vector<PointJob>& jobs, const Scalar* in, Scalar* out, unsigned int threads);
+
+/**
+ * Splits the range into jobs of at most maxCount points.
+ */
+void appendPointJobs(std::vector<PointJob>& jobs, size_t offset, size_t count, size_t transform,
+		size_t maxCount = 65536);
+
+}  // namespace rct
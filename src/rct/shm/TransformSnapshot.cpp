@@ -0,0 +1,336 @@
+/*
+ * TransformSnapshot.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: lziegler
+ */
+
+#include "TransformSnapshot.h"
+#include "../util/Clock.h"
+
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <fcntl.h>
+#include <sched.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace std;
+
+namespace rct {
+
+const string TransformSnapshotWriter::DEFAULT_NAME = "rct-transforms";
+const unsigned int TransformSnapshotWriter::DEFAULT_CAPACITY = 4096;
+const unsigned int TransformSnapshotWriter::NAME_LENGTH;
+
+rsc::logging::LoggerPtr TransformSnapshotWriter::logger = rsc::logging::Logger::getLogger(
+		"rct.TransformSnapshotWriter");
+
+namespace {
+
+const boost::uint32_t MAGIC = 0x52435453; // "RCTS"
+const boost::uint32_t VERSION = 1;
+const unsigned int NAME_LENGTH = TransformSnapshotWriter::NAME_LENGTH;
+
+struct Header {
+	boost::uint32_t magic;
+	boost::uint32_t version;
+	boost::uint32_t capacity;
+	boost::uint32_t slotSize;
+	boost::int64_t writerPid;
+	/** number of valid slots, only ever grows */
+	volatile boost::uint32_t count;
+	boost::uint32_t padding;
+};
+
+struct Slot {
+	/** odd while the writer changes the slot */
+	volatile boost::uint32_t sequence;
+	boost::uint32_t isStatic;
+	boost::uint64_t updates;
+	boost::uint64_t lastReceipt;
+	boost::int64_t stampMicros;
+	double translation[3];
+	double rotation[4];
+	char parent[NAME_LENGTH];
+	char child[NAME_LENGTH];
+	char authority[NAME_LENGTH];
+};
+
+size_t segmentSize(boost::uint32_t capacity) {
+	return sizeof(Header) + capacity * sizeof(Slot);
+}
+
+string segmentPath(const string& name) {
+	return name[0] == '/' ? name : "/" + name;
+}
+
+string systemError(const string& what, const string& path) {
+	return what + " " + path + ": " + strerror(errno);
+}
+
+bool processAlive(boost::int64_t pid) {
+	return pid > 0 && (kill(pid_t(pid), 0) == 0 || errno == EPERM);
+}
+
+void copyName(char* target, const string& name) {
+	memcpy(target, name.c_str(), name.size() + 1);
+}
+
+string readName(const char* source) {
+	return string(source, strnlen(source, NAME_LENGTH - 1));
+}
+
+}  // namespace
+
+/**
+ * A mapped snapshot segment. The writer creates and finally unlinks it.
+ */
+class SnapshotSegment {
+public:
+	SnapshotSegment(const string& path, bool create, boost::uint32_t capacity) :
+			path(path), owner(create), size(0), memory(0) {
+		if (create) {
+			createSegment(capacity);
+		} else {
+			openSegment();
+		}
+	}
+
+	~SnapshotSegment() {
+		if (memory) {
+			munmap(memory, size);
+		}
+		if (owner) {
+			shm_unlink(path.c_str());
+		}
+	}
+
+	Header& header() const {
+		return *static_cast<Header*>(memory);
+	}
+
+	Slot& slot(boost::uint32_t index) const {
+		return reinterpret_cast<Slot*>(static_cast<char*>(memory) + sizeof(Header))[index];
+	}
+
+private:
+	void createSegment(boost::uint32_t capacity) {
+		int fd = shm_open(path.c_str(), O_RDWR | O_CREAT | O_EXCL, 0644);
+		if (fd < 0 && errno == EEXIST) {
+			if (writerAliveAt(path)) {
+				throw runtime_error("snapshot " + path + " is already written by another process");
+			}
+			// left over from a writer that did not shut down cleanly
+			shm_unlink(path.c_str());
+			fd = shm_open(path.c_str(), O_RDWR | O_CREAT | O_EXCL, 0644);
+		}
+		if (fd < 0) {
+			throw runtime_error(systemError("cannot create snapshot", path));
+		}
+		size = segmentSize(capacity);
+		if (ftruncate(fd, size) != 0) {
+			close(fd);
+			shm_unlink(path.c_str());
+			throw runtime_error(systemError("cannot size snapshot", path));
+		}
+		memory = mmap(0, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+		close(fd);
+		if (memory == MAP_FAILED) {
+			memory = 0;
+			shm_unlink(path.c_str());
+			throw runtime_error(systemError("cannot map snapshot", path));
+		}
+
+		// the fresh segment is zeroed, so all slots start even and empty
+		Header& h = header();
+		h.capacity = capacity;
+		h.slotSize = sizeof(Slot);
+		h.writerPid = getpid();
+		h.count = 0;
+		h.version = VERSION;
+		__sync_synchronize();
+		h.magic = MAGIC;
+	}
+
+	void openSegment() {
+		int fd = shm_open(path.c_str(), O_RDONLY, 0);
+		if (fd < 0) {
+			throw runtime_error(systemError("cannot open snapshot", path));
+		}
+		struct stat st;
+		if (fstat(fd, &st) != 0 || size_t(st.st_size) < sizeof(Header)) {
+			close(fd);
+			throw runtime_error("snapshot " + path + " is not initialized");
+		}
+		size = st.st_size;
+		memory = mmap(0, size, PROT_READ, MAP_SHARED, fd, 0);
+		close(fd);
+		if (memory == MAP_FAILED) {
+			memory = 0;
+			throw runtime_error(systemError("cannot map snapshot", path));
+		}
+		const Header& h = header();
+		if (h.magic != MAGIC || h.version != VERSION || h.slotSize != sizeof(Slot)
+				|| size < segmentSize(h.capacity)) {
+			munmap(memory, size);
+			memory = 0;
+			throw runtime_error("snapshot " + path + " has an incompatible layout");
+		}
+	}
+
+	static bool writerAliveAt(const string& path) {
+		try {
+			SnapshotSegment existing(path, false, 0);
+			return processAlive(existing.header().writerPid);
+		} catch (std::runtime_error&) {
+			return false;
+		}
+	}
+
+	string path;
+	bool owner;
+	size_t size;
+	void* memory;
+};
+
+TransformSnapshotWriter::TransformSnapshotWriter(const string& name, unsigned int capacity) :
+		segment(new SnapshotSegment(segmentPath(name), true, capacity)), warnedFull(false) {
+	RSCINFO(logger, "writing snapshot " << segmentPath(name) << " with " << capacity << " slots");
+}
+
+TransformSnapshotWriter::~TransformSnapshotWriter() {
+}
+
+void TransformSnapshotWriter::newTransformAvailable(const Transform& transform, bool isStatic) {
+	const string& child = transform.getFrameChild();
+	if (child.size() >= NAME_LENGTH || transform.getFrameParent().size() >= NAME_LENGTH
+			|| transform.getAuthority().size() >= NAME_LENGTH) {
+		RSCDEBUG(logger, "name too long for snapshot, skipping " << child);
+		return;
+	}
+	boost::uint64_t now = monotonicNanos();
+	static const boost::posix_time::ptime epoch(boost::gregorian::date(1970, 1, 1));
+	boost::int64_t stamp = (transform.getTime() - epoch).total_microseconds();
+	Eigen::Vector3d p = transform.getTranslation();
+	Eigen::Quaterniond q = transform.getRotationQuat();
+
+	boost::mutex::scoped_lock lock(mutex);
+	Header& header = segment->header();
+	bool added = false;
+	map<string, unsigned int>::iterator it = slots.find(child);
+	if (it == slots.end()) {
+		if (header.count >= header.capacity) {
+			if (!warnedFull) {
+				RSCWARN(logger, "snapshot is full, new edges are not stored");
+				warnedFull = true;
+			}
+			return;
+		}
+		it = slots.insert(make_pair(child, header.count)).first;
+		added = true;
+	}
+
+	Slot& slot = segment->slot(it->second);
+	slot.sequence++;
+	__sync_synchronize();
+	slot.isStatic = isStatic;
+	slot.updates++;
+	slot.lastReceipt = now;
+	slot.stampMicros = stamp;
+	slot.translation[0] = p.x();
+	slot.translation[1] = p.y();
+	slot.translation[2] = p.z();
+	slot.rotation[0] = q.w();
+	slot.rotation[1] = q.x();
+	slot.rotation[2] = q.y();
+	slot.rotation[3] = q.z();
+	copyName(slot.parent, transform.getFrameParent());
+	copyName(slot.child, child);
+	copyName(slot.authority, transform.getAuthority());
+	__sync_synchronize();
+	slot.sequence++;
+
+	if (added) {
+		// readers only look at slots below count
+		__sync_synchronize();
+		header.count++;
+	}
+}
+
+size_t TransformSnapshotWriter::edgeCount() const {
+	boost::mutex::scoped_lock lock(mutex);
+	return slots.size();
+}
+
+TransformSnapshotReader::TransformSnapshotReader(const string& name) :
+		segment(new SnapshotSegment(segmentPath(name), false, 0)) {
+}
+
+TransformSnapshotReader::~TransformSnapshotReader() {
+}
+
+vector<SnapshotEdge> TransformSnapshotReader::read() const {
+	static const boost::posix_time::ptime epoch(boost::gregorian::date(1970, 1, 1));
+	const Header& header = segment->header();
+	boost::uint32_t count = header.count;
+	__sync_synchronize();
+
+	vector<SnapshotEdge> edges;
+	edges.reserve(count);
+	for (boost::uint32_t i = 0; i < count; ++i) {
+		const Slot& shared = segment->slot(i);
+		Slot copy;
+		for (unsigned int attempt = 0;; ++attempt) {
+			boost::uint32_t before = shared.sequence;
+			if ((before & 1) == 0) {
+				__sync_synchronize();
+				memcpy(&copy, &shared, sizeof(Slot));
+				__sync_synchronize();
+				if (shared.sequence == before) {
+					break;
+				}
+			}
+			if (attempt > 100) {
+				sched_yield();
+			}
+		}
+
+		Eigen::Vector3d translation(copy.translation[0], copy.translation[1],
+				copy.translation[2]);
+		Eigen::Quaterniond rotation(copy.rotation[0], copy.rotation[1], copy.rotation[2],
+				copy.rotation[3]);
+		Eigen::Affine3d affine = Eigen::Affine3d().fromPositionOrientationScale(translation,
+				rotation, Eigen::Vector3d::Ones());
+
+		SnapshotEdge edge;
+		edge.transform = Transform(affine, readName(copy.parent), readName(copy.child),
+				epoch + boost::posix_time::microseconds(copy.stampMicros));
+		edge.transform.setAuthority(readName(copy.authority));
+		edge.isStatic = copy.isStatic;
+		edge.updates = copy.updates;
+		edge.lastReceipt = copy.lastReceipt;
+		edges.push_back(edge);
+	}
+	return edges;
+}
+
+vector<Transform> TransformSnapshotReader::transforms() const {
+	vector<SnapshotEdge> edges = read();
+	vector<Transform> result;
+	result.reserve(edges.size());
+	vector<SnapshotEdge>::iterator it;
+	for (it = edges.begin(); it != edges.end(); ++it) {
+		result.push_back(it->transform);
+	}
+	return result;
+}
+
+bool TransformSnapshotReader::writerAlive() const {
+	return processAlive(segment->header().writerPid);
+}
+
+}  // namespace rct
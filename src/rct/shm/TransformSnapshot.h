@@ -0,0 +1,114 @@
+/*
+ * TransformSnapshot.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: lziegler
+ */
+
+#pragma once
+
+#include <rct/TransformListener.h>
+#include <rsc/logging/Logger.h>
+
+#include <boost/cstdint.hpp>
+#include <boost/thread/mutex.hpp>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace rct {
+
+class SnapshotSegment;
+
+/**
+ * The latest transform of one edge as read from a snapshot segment.
+ */
+class SnapshotEdge {
+public:
+	SnapshotEdge() :
+			isStatic(false), updates(0), lastReceipt(0) {
+	}
+	Transform transform;
+	bool isStatic;
+	unsigned long updates;
+	/** monotonic receipt time at the writer in nanoseconds */
+	boost::uint64_t lastReceipt;
+};
+
+/**
+ * Keeps the latest transform of every edge in a POSIX shared memory segment,
+ * so that local processes can read them without joining the middleware.
+ *
+ * Edges are keyed by their child frame, as every frame has at most one
+ * parent. Each edge is a fixed size slot guarded by its own sequence counter
+ * (seqlock): the writer never blocks on readers and a reader retries a slot
+ * that changed while it was copied. Frame and authority names longer than
+ * NAME_LENGTH - 1 characters are not stored.
+ *
+ * Register it as listener of a receiver or communicator. The segment is
+ * removed when the writer is destroyed.
+ */
+class TransformSnapshotWriter: public TransformListener {
+public:
+	typedef boost::shared_ptr<TransformSnapshotWriter> Ptr;
+
+	static const std::string DEFAULT_NAME;
+	static const unsigned int DEFAULT_CAPACITY;
+	static const unsigned int NAME_LENGTH = 64;
+
+	/**
+	 * Creates the segment /name. Throws std::runtime_error if it cannot be
+	 * created or another live process already writes it.
+	 */
+	TransformSnapshotWriter(const std::string& name = DEFAULT_NAME,
+			unsigned int capacity = DEFAULT_CAPACITY);
+	virtual ~TransformSnapshotWriter();
+
+	void newTransformAvailable(const Transform& transform, bool isStatic);
+
+	size_t edgeCount() const;
+
+private:
+	boost::shared_ptr<SnapshotSegment> segment;
+	mutable boost::mutex mutex;
+	std::map<std::string, unsigned int> slots;
+	bool warnedFull;
+
+	static rsc::logging::LoggerPtr logger;
+};
+
+/**
+ * Reads the segment of a TransformSnapshotWriter in this or another process.
+ */
+class TransformSnapshotReader {
+public:
+	typedef boost::shared_ptr<TransformSnapshotReader> Ptr;
+
+	/**
+	 * Maps the segment /name read-only. Throws std::runtime_error if there
+	 * is no compatible segment.
+	 */
+	TransformSnapshotReader(const std::string& name = TransformSnapshotWriter::DEFAULT_NAME);
+	virtual ~TransformSnapshotReader();
+
+	/**
+	 * A consistent copy of every edge. Edges are consistent one by one, not
+	 * across edges.
+	 */
+	std::vector<SnapshotEdge> read() const;
+
+	/**
+	 * The latest transforms of all edges, e.g. for FrameGraph.
+	 */
+	std::vector<Transform> transforms() const;
+
+	/**
+	 * False if the writing process has terminated.
+	 */
+	bool writerAlive() const;
+
+private:
+	boost::shared_ptr<SnapshotSegment> segment;
+};
+
+}  // namespace rct
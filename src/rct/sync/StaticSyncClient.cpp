@@ -0,0 +1,38 @@
+/*
+ * StaticSyncClient.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: lziegler
+ */
+
+#include "StaticSyncClient.h"
+#include "StaticSyncServer.h"
+#include "StaticTableCodec.h"
+
+#include <rsb/Factory.h>
+
+using namespace std;
+using namespace rsb;
+
+namespace rct {
+
+rsc::logging::LoggerPtr StaticSyncClient::logger = rsc::logging::Logger::getLogger(
+		"rct.StaticSyncClient");
+
+StaticSyncClient::StaticSyncClient(const Scope& scope, const ParticipantConfig& config) {
+	server = getFactory().createRemoteServer(scope, config, config);
+}
+
+StaticSyncClient::~StaticSyncClient() {
+}
+
+vector<Transform> StaticSyncClient::fetch(unsigned int timeout) {
+	boost::shared_ptr<string> request(new string());
+	boost::shared_ptr<string> reply = server->call<string>(StaticSyncServer::METHOD, request,
+			timeout);
+	vector<Transform> transforms = StaticTableCodec::decode(*reply);
+	RSCDEBUG(logger, "fetched " << transforms.size() << " static transforms");
+	return transforms;
+}
+
+}  // namespace rct
@@ -0,0 +1,42 @@
+/*
+ * StaticSyncClient.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: lziegler
+ */
+
+#pragma once
+
+#include <rct/Transform.h>
+#include <rsb/ParticipantConfig.h>
+#include <rsb/Scope.h>
+#include <rsb/patterns/RemoteServer.h>
+#include <rsc/logging/Logger.h>
+
+#include <boost/shared_ptr.hpp>
+#include <vector>
+
+namespace rct {
+
+/**
+ * Fetches the table of static transforms from a StaticSyncServer.
+ */
+class StaticSyncClient {
+public:
+	typedef boost::shared_ptr<StaticSyncClient> Ptr;
+
+	StaticSyncClient(const rsb::Scope& scope, const rsb::ParticipantConfig& config);
+	virtual ~StaticSyncClient();
+
+	/**
+	 * Throws if the server does not reply within the timeout (seconds).
+	 */
+	std::vector<Transform> fetch(unsigned int timeout = 2);
+
+private:
+	rsb::patterns::RemoteServerPtr server;
+
+	static rsc::logging::LoggerPtr logger;
+};
+
+}  // namespace rct
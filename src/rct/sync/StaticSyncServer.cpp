@@ -0,0 +1,61 @@
+/*
+ * StaticSyncServer.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: lziegler
+ */
+
+#include "StaticSyncServer.h"
+#include "StaticTableCodec.h"
+
+#include <rsb/Factory.h>
+#include <boost/thread/mutex.hpp>
+
+using namespace std;
+using namespace rsb;
+using namespace rsb::patterns;
+
+namespace rct {
+
+const string StaticSyncServer::METHOD = "getStaticTransforms";
+const string StaticSyncServer::DEFAULT_SCOPE = "/rct/sync/static";
+
+rsc::logging::LoggerPtr StaticSyncServer::logger = rsc::logging::Logger::getLogger(
+		"rct.StaticSyncServer");
+
+class StaticSyncServer::Callback: public LocalServer::Callback<string, string> {
+public:
+	Callback() :
+			table(new string(StaticTableCodec::encode(vector<Transform>()))) {
+	}
+	boost::shared_ptr<string> call(const string& methodName, boost::shared_ptr<string> /*request*/) {
+		boost::mutex::scoped_lock lock(mutex);
+		return table;
+	}
+	void setTable(const boost::shared_ptr<string>& table) {
+		boost::mutex::scoped_lock lock(mutex);
+		this->table = table;
+	}
+private:
+	boost::mutex mutex;
+	boost::shared_ptr<string> table;
+};
+
+StaticSyncServer::StaticSyncServer(const Scope& scope, const ParticipantConfig& config) :
+		callback(new Callback()) {
+	server = getFactory().createLocalServer(scope, config, config);
+	server->registerMethod(METHOD, callback);
+	RSCDEBUG(logger, "serving static transforms on " << scope);
+}
+
+StaticSyncServer::~StaticSyncServer() {
+}
+
+void StaticSyncServer::setTransforms(const vector<Transform>& transforms) {
+	boost::shared_ptr<string> table(new string(StaticTableCodec::encode(transforms)));
+	RSCDEBUG(logger, "serialized " << transforms.size() << " static transforms into "
+			<< table->size() << " bytes");
+	callback->setTable(table);
+}
+
+}  // namespace rct
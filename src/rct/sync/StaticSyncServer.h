@@ -0,0 +1,48 @@
+/*
+ * StaticSyncServer.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: lziegler
+ */
+
+#pragma once
+
+#include <rct/Transform.h>
+#include <rsb/ParticipantConfig.h>
+#include <rsb/Scope.h>
+#include <rsb/patterns/LocalServer.h>
+#include <rsc/logging/Logger.h>
+
+#include <boost/shared_ptr.hpp>
+#include <string>
+#include <vector>
+
+namespace rct {
+
+/**
+ * Serves the complete table of static transforms on an rsb request/response
+ * endpoint. The table is serialized once when it is set, so a late joining
+ * receiver gets it in a single round trip.
+ */
+class StaticSyncServer {
+public:
+	typedef boost::shared_ptr<StaticSyncServer> Ptr;
+
+	static const std::string METHOD;
+	static const std::string DEFAULT_SCOPE;
+
+	StaticSyncServer(const rsb::Scope& scope, const rsb::ParticipantConfig& config);
+	virtual ~StaticSyncServer();
+
+	void setTransforms(const std::vector<Transform>& transforms);
+
+private:
+	class Callback;
+
+	boost::shared_ptr<Callback> callback;
+	rsb::patterns::LocalServerPtr server;
+
+	static rsc::logging::LoggerPtr logger;
+};
+
+}  // namespace rct
@@ -0,0 +1,134 @@
+/*
+ * StaticTableCodec.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: lziegler
+ */
+
+#include "StaticTableCodec.h"
+
+#include <boost/cstdint.hpp>
+#include <cstring>
+#include <stdexcept>
+
+using namespace std;
+
+namespace rct {
+
+namespace {
+
+const char MAGIC[4] = { 'R', 'C', 'T', 'S' };
+const boost::uint32_t VERSION = 1;
+
+const boost::posix_time::ptime EPOCH(boost::gregorian::date(1970, 1, 1));
+
+/** three string lengths, the stamp and seven doubles, with empty strings */
+const size_t MIN_RECORD_SIZE = 3 * sizeof(boost::uint32_t) + sizeof(boost::int64_t)
+		+ 7 * sizeof(double);
+
+template<class T>
+void put(string& out, const T& value) {
+	out.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+void putString(string& out, const string& value) {
+	put(out, boost::uint32_t(value.size()));
+	out.append(value);
+}
+
+class Reader {
+public:
+	Reader(const string& data) :
+			data(data), pos(0) {
+	}
+	template<class T>
+	T get() {
+		require(sizeof(T));
+		T value;
+		memcpy(&value, data.data() + pos, sizeof(T));
+		pos += sizeof(T);
+		return value;
+	}
+	string getString() {
+		boost::uint32_t size = get<boost::uint32_t>();
+		require(size);
+		string value = data.substr(pos, size);
+		pos += size;
+		return value;
+	}
+	size_t remaining() const {
+		return data.size() - pos;
+	}
+private:
+	void require(size_t bytes) {
+		if (pos + bytes > data.size()) {
+			throw runtime_error("truncated static transform table");
+		}
+	}
+	const string& data;
+	size_t pos;
+};
+
+}  // namespace
+
+string StaticTableCodec::encode(const vector<Transform>& transforms) {
+	string out;
+	out.append(MAGIC, sizeof(MAGIC));
+	put(out, VERSION);
+	put(out, boost::uint32_t(transforms.size()));
+
+	vector<Transform>::const_iterator it;
+	for (it = transforms.begin(); it != transforms.end(); ++it) {
+		putString(out, it->getFrameParent());
+		putString(out, it->getFrameChild());
+		putString(out, it->getAuthority());
+		put(out, boost::int64_t((it->getTime() - EPOCH).total_microseconds()));
+		Eigen::Vector3d translation = it->getTranslation();
+		Eigen::Quaterniond rotation = it->getRotationQuat();
+		double values[7] = { translation.x(), translation.y(), translation.z(), rotation.w(),
+				rotation.x(), rotation.y(), rotation.z() };
+		out.append(reinterpret_cast<const char*>(values), sizeof(values));
+	}
+	return out;
+}
+
+vector<Transform> StaticTableCodec::decode(const string& data) {
+	if (data.size() < sizeof(MAGIC) || memcmp(data.data(), MAGIC, sizeof(MAGIC)) != 0) {
+		throw runtime_error("not a static transform table");
+	}
+	Reader reader(data);
+	reader.get<boost::uint32_t>();
+	boost::uint32_t version = reader.get<boost::uint32_t>();
+	if (version != VERSION) {
+		throw runtime_error("unsupported static transform table version");
+	}
+	boost::uint32_t count = reader.get<boost::uint32_t>();
+	// the count comes from the network, do not reserve more than can follow
+	if (count > reader.remaining() / MIN_RECORD_SIZE) {
+		throw runtime_error("truncated static transform table");
+	}
+
+	vector<Transform> transforms;
+	transforms.reserve(count);
+	for (boost::uint32_t i = 0; i < count; ++i) {
+		string parent = reader.getString();
+		string child = reader.getString();
+		string authority = reader.getString();
+		boost::posix_time::ptime time = EPOCH
+				+ boost::posix_time::microseconds(reader.get<boost::int64_t>());
+		double values[7];
+		for (unsigned int v = 0; v < 7; ++v) {
+			values[v] = reader.get<double>();
+		}
+		Eigen::Vector3d translation(values[0], values[1], values[2]);
+		Eigen::Quaterniond rotation(values[3], values[4], values[5], values[6]);
+		Eigen::Affine3d affine = Eigen::Affine3d().fromPositionOrientationScale(translation,
+				rotation, Eigen::Vector3d::Ones());
+		Transform t(affine, parent, child, time);
+		t.setAuthority(authority);
+		transforms.push_back(t);
+	}
+	return transforms;
+}
+
+}  // namespace rct
@@ -0,0 +1,31 @@
+/*
+ * StaticTableCodec.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: lziegler
+ */
+
+#pragma once
+
+#include <rct/Transform.h>
+
+#include <string>
+#include <vector>
+
+namespace rct {
+
+/**
+ * Compact binary encoding of a table of static transforms, used by the
+ * static sync service. Numbers are stored in host byte order.
+ */
+class StaticTableCodec {
+public:
+	static std::string encode(const std::vector<Transform>& transforms);
+
+	/**
+	 * Throws std::runtime_error on malformed input.
+	 */
+	static std::vector<Transform> decode(const std::string& data);
+};
+
+}  // namespace rct
@@ -0,0 +1,217 @@
+/*
+ * AllocationCounter.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: lziegler
+ */
+
+#include "AllocationCounter.h"
+
+#include <cstdlib>
+#include <iomanip>
+#include <new>
+#include <malloc.h>
+
+#if __cplusplus >= 201103L
+#define RCT_THROW_BAD_ALLOC
+#define RCT_NO_THROW noexcept
+#else
+#define RCT_THROW_BAD_ALLOC throw (std::bad_alloc)
+#define RCT_NO_THROW throw ()
+#endif
+
+namespace {
+
+// plain integers updated with atomic builtins, so that they are usable before
+// any static initialization has happened
+boost::uint64_t allocations = 0;
+boost::uint64_t deallocations = 0;
+boost::uint64_t bytesAllocated = 0;
+boost::int64_t liveBytes = 0;
+boost::int64_t peakBytes = 0;
+
+boost::uint64_t phaseAllocations[rct::AllocationPhase::PHASE_COUNT];
+boost::uint64_t phaseBytes[rct::AllocationPhase::PHASE_COUNT];
+boost::uint64_t transforms = 0;
+// thread-local, so that phases of concurrent threads do not mix
+__thread int currentPhase = rct::AllocationPhase::OTHER;
+
+void updatePeak(boost::int64_t live) {
+	boost::int64_t peak = __sync_fetch_and_add(&peakBytes, 0);
+	while (live > peak) {
+		boost::int64_t previous = __sync_val_compare_and_swap(&peakBytes, peak, live);
+		if (previous == peak) {
+			break;
+		}
+		peak = previous;
+	}
+}
+
+void* countedAlloc(std::size_t size) {
+	void* p = std::malloc(size == 0 ? 1 : size);
+	if (!p) {
+		throw std::bad_alloc();
+	}
+	boost::int64_t usable = malloc_usable_size(p);
+	__sync_fetch_and_add(&allocations, 1);
+	__sync_fetch_and_add(&bytesAllocated, usable);
+	__sync_fetch_and_add(&phaseAllocations[currentPhase], 1);
+	__sync_fetch_and_add(&phaseBytes[currentPhase], usable);
+	updatePeak(__sync_add_and_fetch(&liveBytes, usable));
+	return p;
+}
+
+void countedFree(void* p) {
+	if (!p) {
+		return;
+	}
+	boost::int64_t usable = malloc_usable_size(p);
+	__sync_fetch_and_add(&deallocations, 1);
+	__sync_fetch_and_sub(&liveBytes, usable);
+	std::free(p);
+}
+
+void printRow(std::ostream& out, const char* name, const rct::AllocationStats& stats,
+		boost::uint64_t count) {
+	out << "  " << std::left << std::setw(10) << name << std::right << std::setw(14)
+			<< stats.allocations << std::setw(16) << stats.bytesAllocated << std::setw(14)
+			<< (count > 0 ? double(stats.allocations) / count : 0.0) << std::setw(14)
+			<< (count > 0 ? double(stats.bytesAllocated) / count : 0.0) << std::endl;
+}
+
+}  // namespace
+
+void* operator new(std::size_t size) RCT_THROW_BAD_ALLOC {
+	return countedAlloc(size);
+}
+
+void* operator new[](std::size_t size) RCT_THROW_BAD_ALLOC {
+	return countedAlloc(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) RCT_NO_THROW {
+	try {
+		return countedAlloc(size);
+	} catch (std::bad_alloc&) {
+		return 0;
+	}
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) RCT_NO_THROW {
+	try {
+		return countedAlloc(size);
+	} catch (std::bad_alloc&) {
+		return 0;
+	}
+}
+
+void operator delete(void* p) RCT_NO_THROW {
+	countedFree(p);
+}
+
+void operator delete[](void* p) RCT_NO_THROW {
+	countedFree(p);
+}
+
+void operator delete(void* p, const std::nothrow_t&) RCT_NO_THROW {
+	countedFree(p);
+}
+
+void operator delete[](void* p, const std::nothrow_t&) RCT_NO_THROW {
+	countedFree(p);
+}
+
+namespace rct {
+
+AllocationPhase::AllocationPhase(Phase phase) :
+		previous(Phase(currentPhase)) {
+	currentPhase = phase;
+}
+
+AllocationPhase::~AllocationPhase() {
+	currentPhase = previous;
+}
+
+const char* AllocationPhase::name(Phase phase) {
+	switch (phase) {
+	case RECEIVE:
+		return "receive";
+	case QUEUE:
+		return "queue";
+	case CONVERT:
+		return "convert";
+	case PUBLISH:
+		return "publish";
+	default:
+		return "other";
+	}
+}
+
+AllocationStats AllocationCounter::snapshot() {
+	AllocationStats stats;
+	stats.allocations = __sync_fetch_and_add(&allocations, 0);
+	stats.deallocations = __sync_fetch_and_add(&deallocations, 0);
+	stats.bytesAllocated = __sync_fetch_and_add(&bytesAllocated, 0);
+	stats.liveBytes = __sync_fetch_and_add(&liveBytes, 0);
+	stats.peakBytes = __sync_fetch_and_add(&peakBytes, 0);
+	return stats;
+}
+
+void AllocationCounter::resetPeak() {
+	__sync_lock_test_and_set(&peakBytes, __sync_fetch_and_add(&liveBytes, 0));
+}
+
+AllocationStats AllocationCounter::difference(const AllocationStats& before,
+		const AllocationStats& after) {
+	AllocationStats diff;
+	diff.allocations = after.allocations - before.allocations;
+	diff.deallocations = after.deallocations - before.deallocations;
+	diff.bytesAllocated = after.bytesAllocated - before.bytesAllocated;
+	diff.liveBytes = after.liveBytes - before.liveBytes;
+	diff.peakBytes = after.peakBytes - before.liveBytes;
+	return diff;
+}
+
+AllocationStats AllocationCounter::phaseSnapshot(AllocationPhase::Phase phase) {
+	AllocationStats stats;
+	stats.allocations = __sync_fetch_and_add(&phaseAllocations[phase], 0);
+	stats.bytesAllocated = __sync_fetch_and_add(&phaseBytes[phase], 0);
+	return stats;
+}
+
+void AllocationCounter::countTransform() {
+	__sync_fetch_and_add(&transforms, 1);
+}
+
+boost::uint64_t AllocationCounter::transformCount() {
+	return __sync_fetch_and_add(&transforms, 0);
+}
+
+void AllocationCounter::report(std::ostream& out) {
+	AllocationStats total = snapshot();
+	boost::uint64_t count = transformCount();
+	// the report itself allocates, so all numbers are read before printing
+	AllocationStats phases[AllocationPhase::PHASE_COUNT];
+	for (int i = 0; i < AllocationPhase::PHASE_COUNT; ++i) {
+		phases[i] = phaseSnapshot(AllocationPhase::Phase(i));
+	}
+
+	std::ios::fmtflags flags = out.flags();
+	std::streamsize precision = out.precision();
+	out << "allocations for " << count << " forwarded transforms" << std::endl;
+	out << "  " << std::left << std::setw(10) << "phase" << std::right << std::setw(14)
+			<< "allocations" << std::setw(16) << "bytes" << std::setw(14) << "allocs/tf"
+			<< std::setw(14) << "bytes/tf" << std::endl;
+	out << std::fixed << std::setprecision(2);
+	for (int i = AllocationPhase::RECEIVE; i < AllocationPhase::PHASE_COUNT; ++i) {
+		printRow(out, AllocationPhase::name(AllocationPhase::Phase(i)), phases[i], count);
+	}
+	printRow(out, AllocationPhase::name(AllocationPhase::OTHER), phases[AllocationPhase::OTHER],
+			count);
+	printRow(out, "total", total, count);
+	out << "  peak live heap " << total.peakBytes << " bytes" << std::endl;
+	out.flags(flags);
+	out.precision(precision);
+}
+
+}  // namespace rct
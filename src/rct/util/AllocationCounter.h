@@ -0,0 +1,105 @@
+/*
+ * AllocationCounter.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: lziegler
+ */
+
+#pragma once
+
+#include "rct-tools-config.h"
+
+#include <boost/cstdint.hpp>
+#include <ostream>
+
+namespace rct {
+
+class AllocationStats {
+public:
+	AllocationStats() :
+			allocations(0), deallocations(0), bytesAllocated(0), liveBytes(0), peakBytes(0) {
+	}
+	boost::uint64_t allocations;
+	boost::uint64_t deallocations;
+	boost::uint64_t bytesAllocated;
+	boost::int64_t liveBytes;
+	boost::int64_t peakBytes;
+};
+
+/**
+ * Attributes the allocations of the calling thread to a phase of forwarding
+ * a transform while it is in scope. Phases nest, the innermost wins.
+ * Allocations outside any phase, e.g. in the receive threads of the
+ * middleware before a tool sees the transform, count as OTHER.
+ *
+ * Use the RCT_ALLOC_PHASE macro, which compiles to nothing unless the tools
+ * are built with allocation accounting.
+ */
+class AllocationPhase {
+public:
+	enum Phase {
+		OTHER, RECEIVE, QUEUE, CONVERT, PUBLISH, PHASE_COUNT
+	};
+
+	AllocationPhase(Phase phase);
+	~AllocationPhase();
+
+	static const char* name(Phase phase);
+
+private:
+	Phase previous;
+};
+
+/**
+ * Counts heap allocations made through the global operator new/delete.
+ *
+ * The counting replacements of the global allocation operators live in
+ * AllocationCounter.cpp. They are only active in executables that link this
+ * translation unit.
+ */
+class AllocationCounter {
+public:
+	/**
+	 * Current totals since process start.
+	 */
+	static AllocationStats snapshot();
+
+	/**
+	 * Sets the peak of live heap bytes to the current number of live bytes,
+	 * so that the next snapshot reports the peak of the following phase.
+	 */
+	static void resetPeak();
+
+	/**
+	 * Difference between two snapshots. The peak is reported relative to the
+	 * live bytes of the first snapshot.
+	 */
+	static AllocationStats difference(const AllocationStats& before, const AllocationStats& after);
+
+	/**
+	 * Allocations and bytes allocated in one phase since process start.
+	 */
+	static AllocationStats phaseSnapshot(AllocationPhase::Phase phase);
+
+	/**
+	 * Counts one forwarded transform, the denominator of report().
+	 */
+	static void countTransform();
+	static boost::uint64_t transformCount();
+
+	/**
+	 * Prints allocations and bytes in total and per phase, each also per
+	 * forwarded transform.
+	 */
+	static void report(std::ostream& out);
+};
+
+}  // namespace rct
+
+#ifdef RCT_ALLOC_ACCOUNTING
+#define RCT_ALLOC_PHASE(phase) ::rct::AllocationPhase rctAllocationPhase(::rct::AllocationPhase::phase)
+#define RCT_ALLOC_COUNT_TRANSFORM() ::rct::AllocationCounter::countTransform()
+#else
+#define RCT_ALLOC_PHASE(phase) do {} while (0)
+#define RCT_ALLOC_COUNT_TRANSFORM() do {} while (0)
+#endif
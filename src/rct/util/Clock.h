@@ -0,0 +1,28 @@
+/*
+ * Clock.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: lziegler
+ */
+
+#pragma once
+
+#include <boost/cstdint.hpp>
+#include <time.h>
+
+namespace rct {
+
+/**
+ * Nanoseconds on the monotonic clock. Only differences are meaningful.
+ */
+inline boost::uint64_t monotonicNanos() {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return boost::uint64_t(ts.tv_sec) * 1000000000ull + ts.tv_nsec;
+}
+
+inline double nanosToMillis(boost::uint64_t nanos) {
+	return nanos / 1000000.0;
+}
+
+}  // namespace rct
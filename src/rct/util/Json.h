@@ -0,0 +1,36 @@
+/*
+ * Json.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: lziegler
+ */
+
+#pragma once
+
+#include <iomanip>
+#include <sstream>
+#include <string>
+
+namespace rct {
+
+/**
+ * The value as a quoted JSON string, with quotes, backslashes and control
+ * characters escaped.
+ */
+inline std::string jsonString(const std::string& value) {
+	std::stringstream ss;
+	ss << '"';
+	for (std::string::const_iterator it = value.begin(); it != value.end(); ++it) {
+		if (*it == '"' || *it == '\\') {
+			ss << '\\' << *it;
+		} else if ((unsigned char) *it < 0x20) {
+			ss << "\\u" << std::hex << std::setw(4) << std::setfill('0') << int(*it) << std::dec;
+		} else {
+			ss << *it;
+		}
+	}
+	ss << '"';
+	return ss.str();
+}
+
+}  // namespace rct
@@ -0,0 +1,81 @@
+/*
+ * LatencyStats.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: lziegler
+ */
+
+#pragma once
+
+#include <boost/cstdint.hpp>
+#include <algorithm>
+#include <vector>
+
+namespace rct {
+
+/**
+ * Collects latency samples in nanoseconds and reports order statistics.
+ */
+class LatencyStats {
+public:
+	LatencyStats() :
+			sorted(true), total(0) {
+	}
+
+	void add(boost::uint64_t nanos) {
+		samples.push_back(nanos);
+		total += nanos;
+		sorted = false;
+	}
+
+	void clear() {
+		samples.clear();
+		total = 0;
+		sorted = true;
+	}
+
+	size_t count() const {
+		return samples.size();
+	}
+
+	boost::uint64_t min() {
+		return percentile(0.0);
+	}
+
+	boost::uint64_t max() {
+		return percentile(1.0);
+	}
+
+	double mean() const {
+		return samples.empty() ? 0.0 : double(total) / samples.size();
+	}
+
+	/**
+	 * Nearest-rank percentile, fraction in [0, 1].
+	 */
+	boost::uint64_t percentile(double fraction) {
+		if (samples.empty()) {
+			return 0;
+		}
+		if (!sorted) {
+			std::sort(samples.begin(), samples.end());
+			sorted = true;
+		}
+		size_t index = size_t(fraction * (samples.size() - 1) + 0.5);
+		return samples[std::min(index, samples.size() - 1)];
+	}
+
+	/**
+	 * Sum of all samples, which is the busy time of sequential operations.
+	 */
+	boost::uint64_t sum() const {
+		return total;
+	}
+
+private:
+	std::vector<boost::uint64_t> samples;
+	bool sorted;
+	boost::uint64_t total;
+};
+
+}  // namespace rct
@@ -0,0 +1,98 @@
+/*
+ * NameInterner.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: lziegler
+ */
+
+#pragma once
+
+#include <boost/cstdint.hpp>
+#include <boost/unordered_map.hpp>
+#include <deque>
+#include <stdexcept>
+#include <string>
+
+namespace rct {
+
+/**
+ * Maps frame and authority names to dense ids, starting at 0 in the order
+ * of first use. Every name is stored once; references returned by name()
+ * stay valid for the lifetime of the interner.
+ *
+ * Not thread-safe. Each hot path keeps its own interner.
+ */
+class NameInterner {
+public:
+	typedef boost::uint32_t Id;
+
+	/**
+	 * The id of the name, which is added if unknown.
+	 */
+	Id intern(const std::string& name) {
+		Map::const_iterator it = ids.find(name);
+		if (it != ids.end()) {
+			return it->second;
+		}
+		Id id = names.size();
+		names.push_back(name);
+		ids.insert(std::make_pair(name, id));
+		return id;
+	}
+
+	/**
+	 * Looks up the id of a known name without adding it.
+	 */
+	bool find(const std::string& name, Id& id) const {
+		Map::const_iterator it = ids.find(name);
+		if (it == ids.end()) {
+			return false;
+		}
+		id = it->second;
+		return true;
+	}
+
+	const std::string& name(Id id) const {
+		if (id >= names.size()) {
+			throw std::out_of_range("unknown name id");
+		}
+		return names[id];
+	}
+
+	size_t size() const {
+		return names.size();
+	}
+
+private:
+	typedef boost::unordered_map<std::string, Id> Map;
+
+	Map ids;
+	// a deque does not move its elements on push_back
+	std::deque<std::string> names;
+};
+
+/**
+ * Builds prefix + name once per distinct name, e.g. the "rct:" authorities
+ * of the bridge, and hands out the cached string afterwards.
+ */
+class PrefixedNames {
+public:
+	PrefixedNames(const std::string& prefix) :
+			prefix(prefix) {
+	}
+
+	const std::string& get(const std::string& name) {
+		NameInterner::Id id = names.intern(name);
+		if (id == prefixed.size()) {
+			prefixed.push_back(prefix + name);
+		}
+		return prefixed[id];
+	}
+
+private:
+	std::string prefix;
+	NameInterner names;
+	std::deque<std::string> prefixed;
+};
+
+}  // namespace rct
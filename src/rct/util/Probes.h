@@ -0,0 +1,38 @@
+/*
+ * Probes.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: lziegler
+ */
+
+#pragma once
+
+#include "rct-tools-config.h"
+
+/**
+ * Static tracepoints (USDT) for perf, bpftrace and SystemTap.
+ *
+ * With RCT_PROBES each probe compiles to a single nop plus a note in the
+ * .note.stapsdt section, so a disabled probe costs no formatting and no
+ * branch. Probes are listed with
+ *
+ *   perf probe -x rct-ros-bridge --list-sdt  or  bpftrace -l 'usdt:./rct-ros-bridge:*'
+ *
+ * The arguments are evaluated even if nobody is attached. Only pass values
+ * that are already at hand, like sizes or the c_str() of existing strings.
+ *
+ * Without RCT_PROBES the macros expand to nothing.
+ */
+
+#ifdef RCT_PROBES
+#include <sys/sdt.h>
+#define RCT_PROBE0(provider, name) DTRACE_PROBE(provider, name)
+#define RCT_PROBE1(provider, name, a1) DTRACE_PROBE1(provider, name, a1)
+#define RCT_PROBE2(provider, name, a1, a2) DTRACE_PROBE2(provider, name, a1, a2)
+#define RCT_PROBE3(provider, name, a1, a2, a3) DTRACE_PROBE3(provider, name, a1, a2, a3)
+#else
+#define RCT_PROBE0(provider, name) do {} while (0)
+#define RCT_PROBE1(provider, name, a1) do {} while (0)
+#define RCT_PROBE2(provider, name, a1, a2) do {} while (0)
+#define RCT_PROBE3(provider, name, a1, a2, a3) do {} while (0)
+#endif
@@ -0,0 +1,293 @@
+/*
+ * Realtime.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: lziegler
+ */
+
+#include "Realtime.h"
+#include "Clock.h"
+#include "LatencyStats.h"
+
+#include <boost/algorithm/string.hpp>
+#include <boost/lexical_cast.hpp>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <stdexcept>
+#include <malloc.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <time.h>
+#include <unistd.h>
+
+using namespace std;
+namespace po = boost::program_options;
+
+namespace rct {
+
+rsc::logging::LoggerPtr RealtimeOptions::logger = rsc::logging::Logger::getLogger(
+		"rct.Realtime");
+rsc::logging::LoggerPtr WakeupLatencyMonitor::logger = rsc::logging::Logger::getLogger(
+		"rct.WakeupLatencyMonitor");
+
+namespace {
+
+/** stack of the calling thread to fault in with the heap */
+const size_t PREFAULT_STACK = 256 * 1024;
+
+/** default stack of new threads when memory is locked, instead of 8 MiB */
+const size_t LOCKED_THREAD_STACK = 1024 * 1024;
+
+void prefaultStack() {
+	char stack[PREFAULT_STACK];
+	volatile char* page = stack;
+	for (size_t i = 0; i < PREFAULT_STACK; i += 4096) {
+		page[i] = 0;
+	}
+}
+
+/**
+ * Locks the current pages and, where the kernel supports it, future pages
+ * only once they are touched, so that untouched parts of thread stacks are
+ * not faulted in. The memlock limit still counts whole mappings.
+ */
+int lockAllPages() {
+#ifdef MCL_ONFAULT
+	if (mlockall(MCL_CURRENT) != 0) {
+		return -1;
+	}
+	// leaves the current pages locked
+	if (mlockall(MCL_FUTURE | MCL_ONFAULT) == 0) {
+		return 0;
+	}
+	if (errno != EINVAL) {
+		return -1;
+	}
+	// kernels before 4.4
+#endif
+	return mlockall(MCL_CURRENT | MCL_FUTURE);
+}
+
+}  // namespace
+
+RealtimeOptions::RealtimeOptions() :
+		policy("other"), priority(0), lockMemory(false), threadStack(0), prefaultHeap(0), wakeupReportInterval(
+				0.0) {
+}
+
+RealtimeOptions::RealtimeOptions(const po::variables_map& vm) :
+		policy(vm["rt-policy"].as<string>()), priority(vm["rt-priority"].as<int>()), lockMemory(
+				vm.count("lock-memory")), threadStack(
+				size_t(vm["thread-stack"].as<unsigned int>()) * 1024), prefaultHeap(
+				size_t(vm["prefault-heap"].as<unsigned int>()) * 1024 * 1024), wakeupReportInterval(
+				0.0) {
+	if (lockMemory && threadStack == 0) {
+		threadStack = LOCKED_THREAD_STACK;
+	}
+	if (policy != "other" && policy != "fifo" && policy != "rr") {
+		throw invalid_argument("unknown scheduling policy " + policy);
+	}
+	if (vm.count("cpus")) {
+		cpus = parseCpus(vm["cpus"].as<string>());
+	}
+	if (vm.count("wakeup-latency")) {
+		wakeupReportInterval = vm["wakeup-latency"].as<double>();
+	}
+}
+
+po::options_description RealtimeOptions::description() {
+	po::options_description desc("Real-time options");
+	desc.add_options()("rt-policy", po::value<string>()->default_value("other"),
+			"scheduling policy of the forwarding threads: other, fifo or rr") // policy
+	("rt-priority", po::value<int>()->default_value(50),
+			"real-time priority for fifo and rr (1-99)") // priority
+	("cpus", po::value<string>(), "pin the forwarding threads to these cpus, e.g. 2,3 or 2-3") // affinity
+	("lock-memory",
+			"lock all current and future pages in memory, new threads get 1 MiB stacks unless --thread-stack is given") // mlockall
+	("thread-stack", po::value<unsigned int>()->default_value(0),
+			"default stack size of new threads (KiB), 0 for the system default") // thread stack
+	("prefault-heap", po::value<unsigned int>()->default_value(0),
+			"fault in this much heap at startup and never return it (MiB)") // prefault
+	("wakeup-latency", po::value<double>(),
+			"measure the wake-up latency of a thread with the same scheduling and report it at this interval (seconds)"); // wakeup latency
+	return desc;
+}
+
+vector<int> RealtimeOptions::parseCpus(const string& list) {
+	vector<int> result;
+	vector<string> ranges;
+	boost::split(ranges, list, boost::is_any_of(","));
+	vector<string>::const_iterator it;
+	for (it = ranges.begin(); it != ranges.end(); ++it) {
+		string range = boost::trim_copy(*it);
+		if (range.empty()) {
+			continue;
+		}
+		try {
+			string::size_type dash = range.find('-');
+			int first = boost::lexical_cast<int>(range.substr(0, dash));
+			int last = first;
+			if (dash != string::npos) {
+				last = boost::lexical_cast<int>(range.substr(dash + 1));
+			}
+			if (first < 0 || last < first || last >= CPU_SETSIZE) {
+				throw invalid_argument(range);
+			}
+			for (int cpu = first; cpu <= last; ++cpu) {
+				result.push_back(cpu);
+			}
+		} catch (std::exception& e) {
+			throw invalid_argument("invalid cpu list " + list);
+		}
+	}
+	return result;
+}
+
+bool RealtimeOptions::reportWakeupLatency() const {
+	return wakeupReportInterval > 0.0;
+}
+
+void RealtimeOptions::apply() const {
+	if (!cpus.empty()) {
+		cpu_set_t set;
+		CPU_ZERO(&set);
+		vector<int>::const_iterator it;
+		for (it = cpus.begin(); it != cpus.end(); ++it) {
+			CPU_SET(*it, &set);
+		}
+		int error = pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+		if (error != 0) {
+			throw runtime_error(string("cannot set cpu affinity: ") + strerror(error));
+		}
+		RSCINFO(logger, "pinned to " << cpus.size() << " cpus");
+	}
+
+	if (policy != "other") {
+		int schedPolicy = policy == "fifo" ? SCHED_FIFO : SCHED_RR;
+		int minPriority = sched_get_priority_min(schedPolicy);
+		int maxPriority = sched_get_priority_max(schedPolicy);
+		if (priority < minPriority || priority > maxPriority) {
+			throw invalid_argument(
+					"real-time priority must be between " + boost::lexical_cast<string>(minPriority)
+							+ " and " + boost::lexical_cast<string>(maxPriority));
+		}
+		struct sched_param param;
+		memset(&param, 0, sizeof(param));
+		param.sched_priority = priority;
+		int error = pthread_setschedparam(pthread_self(), schedPolicy, &param);
+		if (error != 0) {
+			throw runtime_error(
+					"cannot set " + policy + " scheduling with priority "
+							+ boost::lexical_cast<string>(priority) + ": " + strerror(error)
+							+ " (needs CAP_SYS_NICE or an rtprio limit)");
+		}
+		RSCINFO(logger, "scheduling " << policy << " with priority " << priority);
+	}
+
+	if (threadStack > 0) {
+		// locked stacks count against the memlock limit as a whole, so the
+		// default of 8 MiB would make thread creation fail early
+		pthread_attr_t attr;
+		pthread_attr_init(&attr);
+		int error = pthread_attr_setstacksize(&attr, threadStack);
+		if (error == 0) {
+			error = pthread_setattr_default_np(&attr);
+		}
+		pthread_attr_destroy(&attr);
+		if (error != 0) {
+			throw runtime_error(string("cannot set the thread stack size: ") + strerror(error));
+		}
+		RSCINFO(logger, "thread stacks of " << threadStack / 1024 << " KiB");
+	}
+
+	if (prefaultHeap > 0) {
+		// keep freed memory in the process and in a single arena, so that
+		// later allocations of all threads hit pages that are already mapped
+		mallopt(M_TRIM_THRESHOLD, -1);
+		mallopt(M_MMAP_MAX, 0);
+		mallopt(M_ARENA_MAX, 1);
+	}
+	if (lockMemory) {
+		if (lockAllPages() != 0) {
+			throw runtime_error(
+					string("cannot lock memory: ") + strerror(errno)
+							+ " (needs CAP_IPC_LOCK or a memlock limit)");
+		}
+		RSCINFO(logger, "locked memory");
+	}
+	if (prefaultHeap > 0) {
+		char* heap = static_cast<char*>(malloc(prefaultHeap));
+		if (!heap) {
+			throw runtime_error("cannot allocate the heap to prefault");
+		}
+		long pageSize = sysconf(_SC_PAGESIZE);
+		for (size_t i = 0; i < prefaultHeap; i += pageSize) {
+			heap[i] = 0;
+		}
+		free(heap);
+		prefaultStack();
+		RSCINFO(logger, "prefaulted " << prefaultHeap / (1024 * 1024) << " MiB of heap");
+	}
+}
+
+WakeupLatencyMonitor::WakeupLatencyMonitor(ostream& out, double reportInterval, double period) :
+		out(out), reportInterval(reportInterval), period(period), stopped(false) {
+	thread = boost::thread(&WakeupLatencyMonitor::run, this);
+}
+
+WakeupLatencyMonitor::~WakeupLatencyMonitor() {
+	stop();
+}
+
+void WakeupLatencyMonitor::stop() {
+	stopped = true;
+	if (thread.joinable()) {
+		thread.join();
+	}
+}
+
+void WakeupLatencyMonitor::run() {
+	boost::uint64_t step = boost::uint64_t(period * 1000000000.0);
+	boost::uint64_t reportStep = boost::uint64_t(reportInterval * 1000000000.0);
+	LatencyStats stats;
+	// clear() keeps the capacity, so measuring does not allocate
+	for (boost::uint64_t i = 0; i <= reportStep / step; ++i) {
+		stats.add(0);
+	}
+	stats.clear();
+
+	boost::uint64_t next = monotonicNanos();
+	boost::uint64_t nextReport = next + reportStep;
+	while (!stopped) {
+		next += step;
+		struct timespec ts;
+		ts.tv_sec = next / 1000000000ull;
+		ts.tv_nsec = next % 1000000000ull;
+		while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL) == EINTR) {
+		}
+		boost::uint64_t now = monotonicNanos();
+		stats.add(now > next ? now - next : 0);
+		if (now >= nextReport) {
+			ios::fmtflags flags = out.flags();
+			streamsize precision = out.precision();
+			out << "wake-up latency over " << stats.count() << " wake-ups (usec): min "
+					<< stats.min() / 1000 << " mean " << fixed << setprecision(1)
+					<< stats.mean() / 1000.0 << " p99 " << stats.percentile(0.99) / 1000 << " max "
+					<< stats.max() / 1000 << endl;
+			out.flags(flags);
+			out.precision(precision);
+			RSCDEBUG(logger, "max wake-up latency " << stats.max() << " ns");
+			stats.clear();
+			nextReport = now + reportStep;
+		}
+		if (now > next + step) {
+			// overran, do not try to catch up
+			next = now;
+		}
+	}
+}
+
+}  // namespace rct
@@ -0,0 +1,96 @@
+/*
+ * Realtime.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: lziegler
+ */
+
+#pragma once
+
+#include <rsc/logging/Logger.h>
+
+#include <boost/program_options.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/thread.hpp>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace rct {
+
+/**
+ * Scheduling and memory options shared by the forwarding tools.
+ *
+ * apply() changes the calling thread. Threads inherit policy, priority and
+ * affinity from the thread that creates them, so tools apply the options
+ * before they create communicators, listeners or spinners. The middleware
+ * threads that deliver and forward transforms then run with them as well.
+ */
+class RealtimeOptions {
+public:
+	RealtimeOptions();
+	RealtimeOptions(const boost::program_options::variables_map& vm);
+
+	/**
+	 * The option group to add to a tool's options_description.
+	 */
+	static boost::program_options::options_description description();
+
+	/**
+	 * Applies the options to the calling thread and the process. Throws
+	 * std::runtime_error if the system refuses, e.g. without CAP_SYS_NICE or
+	 * an rtprio limit for real-time scheduling, or without CAP_IPC_LOCK or a
+	 * sufficient memlock limit for locking memory.
+	 */
+	void apply() const;
+
+	/**
+	 * True if a wake-up latency report was requested.
+	 */
+	bool reportWakeupLatency() const;
+
+	/** "other", "fifo" or "rr" */
+	std::string policy;
+	int priority;
+	std::vector<int> cpus;
+	bool lockMemory;
+	/** default stack size of new threads in bytes, 0 for the system default */
+	size_t threadStack;
+	/** heap to fault in and keep, in bytes */
+	size_t prefaultHeap;
+	/** seconds between two wake-up latency reports, 0 for none */
+	double wakeupReportInterval;
+
+private:
+	static std::vector<int> parseCpus(const std::string& list);
+
+	static rsc::logging::LoggerPtr logger;
+};
+
+/**
+ * Measures how late a thread with the scheduling of its creator wakes up
+ * from an absolute sleep, like cyclictest, and reports minimum, mean, 99th
+ * percentile and maximum once per report interval.
+ */
+class WakeupLatencyMonitor {
+public:
+	typedef boost::shared_ptr<WakeupLatencyMonitor> Ptr;
+
+	WakeupLatencyMonitor(std::ostream& out, double reportInterval, double period = 0.001);
+	virtual ~WakeupLatencyMonitor();
+
+	void stop();
+
+private:
+	void run();
+
+	std::ostream& out;
+	double reportInterval;
+	double period;
+	volatile bool stopped;
+	boost::thread thread;
+
+	static rsc::logging::LoggerPtr logger;
+};
+
+}  // namespace rct
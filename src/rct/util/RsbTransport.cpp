@@ -0,0 +1,39 @@
+/*
+ * RsbTransport.cpp
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: lziegler
+ */
+
+#include "RsbTransport.h"
+
+#include <rsb/Factory.h>
+
+#include <cstdlib>
+#include <set>
+
+using namespace std;
+using namespace rsb;
+
+namespace rct {
+
+ParticipantConfig inprocessParticipantConfig() {
+	ParticipantConfig config = getFactory().getDefaultParticipantConfig();
+	set<ParticipantConfig::Transport> transports = config.getTransports(true);
+	set<ParticipantConfig::Transport>::const_iterator it;
+	for (it = transports.begin(); it != transports.end(); ++it) {
+		config.mutableTransport(it->getName()).setEnabled(false);
+	}
+	config.mutableTransport("inprocess").setEnabled(true);
+	return config;
+}
+
+void useInprocessTransportOnly() {
+	// the default participant config is read from the environment when the
+	// factory is created
+	setenv("RSB_TRANSPORT_INPROCESS_ENABLED", "1", 1);
+	setenv("RSB_TRANSPORT_SOCKET_ENABLED", "0", 1);
+	setenv("RSB_TRANSPORT_SPREAD_ENABLED", "0", 1);
+}
+
+}  // namespace rct
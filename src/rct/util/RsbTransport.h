@@ -0,0 +1,27 @@
+/*
+ * RsbTransport.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: lziegler
+ */
+
+#pragma once
+
+#include <rsb/ParticipantConfig.h>
+
+namespace rct {
+
+/**
+ * Copy of the default participant config with all transports disabled
+ * except the in-process one. Participants using it never leave the process.
+ */
+rsb::ParticipantConfig inprocessParticipantConfig();
+
+/**
+ * Makes the in-process transport the only enabled transport of the default
+ * participant config, including participants created inside the rct
+ * library. Must be called before the first use of the rsb factory.
+ */
+void useInprocessTransportOnly();
+
+}  // namespace rct
@@ -0,0 +1,113 @@
+/*
+ * StartupProfiler.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: lziegler
+ */
+
+#pragma once
+
+#include "Clock.h"
+
+#include <boost/cstdint.hpp>
+#include <fstream>
+#include <iomanip>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+#include <time.h>
+#include <unistd.h>
+
+namespace rct {
+
+/**
+ * Splits the startup of a tool into named phases. Create it first thing in
+ * main, call mark() at the end of every phase and report() once the tool is
+ * ready. Marking costs one clock read, so tools mark unconditionally and
+ * only report on request.
+ */
+class StartupProfiler {
+public:
+	StartupProfiler() :
+			start(monotonicNanos()), last(start), beforeMain(timeSinceExec()) {
+	}
+
+	/**
+	 * Ends the current phase. A phase marked twice is reported twice.
+	 */
+	void mark(const std::string& phase) {
+		boost::uint64_t now = monotonicNanos();
+		phases.push_back(std::make_pair(phase, now - last));
+		last = now;
+	}
+
+	/**
+	 * Prints the phases in milliseconds with their share of the time since
+	 * main was entered. The time between exec and main, i.e. loading the
+	 * shared libraries and static initialization, is listed separately. It
+	 * has the resolution of the kernel clock tick.
+	 */
+	void report(std::ostream& out) const {
+		boost::uint64_t total = last - start;
+		std::ios::fmtflags flags = out.flags();
+		out << "startup profile" << std::endl;
+		out << std::fixed << std::setprecision(3);
+		if (beforeMain > 0) {
+			out << "  " << std::left << std::setw(32) << "exec to main" << std::right
+					<< std::setw(12) << nanosToMillis(beforeMain) << " ms" << std::endl;
+		}
+		std::vector<std::pair<std::string, boost::uint64_t> >::const_iterator it;
+		for (it = phases.begin(); it != phases.end(); ++it) {
+			out << "  " << std::left << std::setw(32) << it->first << std::right
+					<< std::setw(12) << nanosToMillis(it->second) << " ms" << std::setprecision(1)
+					<< std::setw(8) << (total > 0 ? 100.0 * it->second / total : 0.0) << " %"
+					<< std::setprecision(3) << std::endl;
+		}
+		out << "  " << std::left << std::setw(32) << "total since main" << std::right
+				<< std::setw(12) << nanosToMillis(total) << " ms" << std::endl;
+		out.flags(flags);
+	}
+
+	/**
+	 * Nanoseconds since the kernel started this process, 0 if unknown.
+	 */
+	static boost::uint64_t timeSinceExec() {
+		std::ifstream in("/proc/self/stat");
+		std::string stat;
+		if (!std::getline(in, stat)) {
+			return 0;
+		}
+		// the command name in parentheses may contain spaces
+		std::string::size_type pos = stat.rfind(')');
+		if (pos == std::string::npos) {
+			return 0;
+		}
+		std::istringstream fields(stat.substr(pos + 1));
+		std::string field;
+		// starttime is field 22, the first after the name is field 3
+		for (int i = 3; i < 22 && (fields >> field); ++i) {
+		}
+		unsigned long long ticks;
+		if (!(fields >> ticks)) {
+			return 0;
+		}
+		long ticksPerSecond = sysconf(_SC_CLK_TCK);
+		struct timespec ts;
+		if (ticksPerSecond <= 0 || clock_gettime(CLOCK_BOOTTIME, &ts) != 0) {
+			return 0;
+		}
+		boost::uint64_t now = boost::uint64_t(ts.tv_sec) * 1000000000ull + ts.tv_nsec;
+		boost::uint64_t started = ticks * (1000000000ull / ticksPerSecond);
+		return now > started ? now - started : 0;
+	}
+
+private:
+	boost::uint64_t start;
+	boost::uint64_t last;
+	boost::uint64_t beforeMain;
+	std::vector<std::pair<std::string, boost::uint64_t> > phases;
+};
+
+}  // namespace rct
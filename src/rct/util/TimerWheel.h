@@ -0,0 +1,163 @@
+/*
+ * TimerWheel.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: lziegler
+ */
+
+#pragma once
+
+#include <boost/cstdint.hpp>
+#include <vector>
+
+namespace rct {
+
+/**
+ * Hierarchical timer wheel for many timers with coarse deadlines, e.g. one
+ * per edge of the transform graph.
+ *
+ * Timers are identified by dense ids, such as those of a NameInterner, and
+ * deadlines are given in ticks of a resolution chosen by the caller. LEVELS
+ * wheels of SLOTS slots each cover SLOTS^LEVELS ticks; farther deadlines are
+ * parked in the top level and placed again until they are in range.
+ * schedule() and cancel() are O(1). advance() touches each timer once per
+ * level it cascades through, never all timers.
+ *
+ * Not thread-safe.
+ */
+class TimerWheel {
+public:
+	typedef boost::uint32_t Id;
+
+	static const unsigned int BITS = 6;
+	static const unsigned int SLOTS = 1 << BITS;
+	static const unsigned int LEVELS = 4;
+
+	TimerWheel(boost::uint64_t now = 0) :
+			current(now), wheel(LEVELS * SLOTS, NONE) {
+	}
+
+	/**
+	 * Sets the deadline of the timer, replacing a pending one. A deadline that
+	 * already passed fires on the next advance().
+	 */
+	void schedule(Id id, boost::uint64_t deadline) {
+		if (id >= timers.size()) {
+			timers.resize(id + 1);
+		}
+		unlink(id);
+		timers[id].deadline = deadline;
+		place(id, current + 1);
+	}
+
+	void cancel(Id id) {
+		if (id < timers.size()) {
+			unlink(id);
+		}
+	}
+
+	bool pending(Id id) const {
+		return id < timers.size() && timers[id].slot != NONE;
+	}
+
+	/**
+	 * Moves the wheel to now and appends the timers that expired to expired.
+	 * Expired timers are no longer pending.
+	 */
+	void advance(boost::uint64_t now, std::vector<Id>& expired) {
+		while (current < now) {
+			++current;
+			for (unsigned int level = 1; level < LEVELS; ++level) {
+				if (current & ((boost::uint64_t(1) << (BITS * level)) - 1)) {
+					break;
+				}
+				cascade(level * SLOTS + ((current >> (BITS * level)) & (SLOTS - 1)));
+			}
+			boost::uint32_t slot = current & (SLOTS - 1);
+			Id id = wheel[slot];
+			while (id != NONE) {
+				Id next = timers[id].next;
+				unlink(id);
+				if (timers[id].deadline <= current) {
+					expired.push_back(id);
+				} else {
+					// a parked deadline beyond the range of the top level
+					place(id, current + 1);
+				}
+				id = next;
+			}
+		}
+	}
+
+	boost::uint64_t now() const {
+		return current;
+	}
+
+private:
+	static const Id NONE = 0xffffffff;
+
+	struct Timer {
+		Timer() :
+				deadline(0), slot(NONE), prev(NONE), next(NONE) {
+		}
+		boost::uint64_t deadline;
+		boost::uint32_t slot;
+		Id prev;
+		Id next;
+	};
+
+	/**
+	 * Links the timer into the slot of its deadline, but not before earliest.
+	 * Cascading passes the current tick, whose level 0 slot is processed
+	 * right afterwards.
+	 */
+	void place(Id id, boost::uint64_t earliest) {
+		Timer& timer = timers[id];
+		boost::uint64_t deadline = timer.deadline > earliest ? timer.deadline : earliest;
+		boost::uint64_t delta = deadline - current;
+		unsigned int level = 0;
+		while (level + 1 < LEVELS && delta >= (boost::uint64_t(1) << (BITS * (level + 1)))) {
+			++level;
+		}
+		timer.slot = level * SLOTS + ((deadline >> (BITS * level)) & (SLOTS - 1));
+		timer.prev = NONE;
+		timer.next = wheel[timer.slot];
+		if (timer.next != NONE) {
+			timers[timer.next].prev = id;
+		}
+		wheel[timer.slot] = id;
+	}
+
+	void unlink(Id id) {
+		Timer& timer = timers[id];
+		if (timer.slot == NONE) {
+			return;
+		}
+		if (timer.prev != NONE) {
+			timers[timer.prev].next = timer.next;
+		} else {
+			wheel[timer.slot] = timer.next;
+		}
+		if (timer.next != NONE) {
+			timers[timer.next].prev = timer.prev;
+		}
+		timer.slot = NONE;
+	}
+
+	void cascade(boost::uint32_t slot) {
+		Id id = wheel[slot];
+		while (id != NONE) {
+			Id next = timers[id].next;
+			unlink(id);
+			place(id, current);
+			id = next;
+		}
+	}
+
+	boost::uint64_t current;
+	/** head of the timer list of every slot, level by level */
+	std::vector<Id> wheel;
+	std::vector<Timer> timers;
+};
+
+}  // namespace rct
@@ -0,0 +1,308 @@
+#include <QtGui>
+#include <QAction>
+#include <QApplication>
+#include <QGraphicsPathItem>
+#include <QGraphicsPolygonItem>
+#include <QGraphicsRectItem>
+#include <QGraphicsScene>
+#include <QGraphicsSimpleTextItem>
+#include <QGraphicsView>
+#include <QMenu>
+#include <QMenuBar>
+#include <QMessageBox>
+#include <QTimer>
+#include <QWheelEvent>
+
+#include <cmath>
+
+#include "graphviewer.h"
+#include "../graph/TreeLayout.h"
+#include "../util/Clock.h"
+
+using namespace std;
+using namespace rct;
+
+namespace {
+
+const double NODE_PADDING = 6.0;
+const double HORIZONTAL_GAP = 30.0;
+const double LAYER_HEIGHT = 110.0;
+const double ARROW_SIZE = 8.0;
+
+}  // namespace
+
+GraphViewer::GraphViewer() :
+		scaleFactor(1.0), fitted(false), staleFactor(0.0), timer(0) {
+	scene = new QGraphicsScene(this);
+	scene->setItemIndexMethod(QGraphicsScene::NoIndex);
+
+	view = new QGraphicsView(scene, this);
+	view->setRenderHint(QPainter::Antialiasing);
+	view->setDragMode(QGraphicsView::ScrollHandDrag);
+	view->setViewportUpdateMode(QGraphicsView::MinimalViewportUpdate);
+	view->setTransformationAnchor(QGraphicsView::AnchorUnderMouse);
+	view->viewport()->installEventFilter(this);
+	setCentralWidget(view);
+
+	createActions();
+	createMenus();
+
+	setWindowTitle(tr("rct-view"));
+
+	QSettings settings;
+	setGeometry(settings.value("main/windowgeometry", QRect(0, 0, 500, 400)).toRect());
+}
+
+GraphViewer::~GraphViewer() {
+	QSettings settings;
+	settings.setValue("main/windowgeometry", geometry());
+}
+
+GraphViewer::NodeItems &GraphViewer::node(const string &name) {
+	NodeMap::iterator it = nodes.find(name);
+	if (it != nodes.end()) {
+		return it->second;
+	}
+	NodeItems &items = nodes[name];
+	items.box = scene->addRect(QRectF(), QPen(Qt::black), QBrush(Qt::white));
+	items.box->setZValue(1);
+	items.label = new QGraphicsSimpleTextItem(QString::fromStdString(name), items.box);
+	QRectF text = items.label->boundingRect();
+	items.label->setPos(NODE_PADDING, NODE_PADDING);
+	items.box->setRect(0, 0, text.width() + 2 * NODE_PADDING, text.height() + 2 * NODE_PADDING);
+	return items;
+}
+
+GraphViewer::EdgeItems &GraphViewer::edge(const EdgeInfo &info) {
+	pair<string, string> key(info.parent, info.child);
+	EdgeMap::iterator it = edges.find(key);
+	if (it != edges.end()) {
+		return it->second;
+	}
+	EdgeItems &items = edges[key];
+	items.line = scene->addPath(QPainterPath());
+	items.arrow = scene->addPolygon(QPolygonF(), QPen(Qt::NoPen), QBrush(Qt::black));
+	items.label = scene->addSimpleText(QString());
+	items.label->setBrush(QBrush(Qt::darkGray));
+	return items;
+}
+
+QString GraphViewer::edgeLabel(const EdgeInfo &info) const {
+	QString label = QString::fromStdString(info.authority);
+	if (info.isStatic) {
+		label += "\nstatic";
+	} else {
+		label += QString("\n%1 Hz").arg(info.rate(), 0, 'f', 1);
+	}
+	return label;
+}
+
+void GraphViewer::updateEdge(EdgeItems &items) {
+	QGraphicsRectItem *parentBox = node(items.info.parent).box;
+	QGraphicsRectItem *childBox = node(items.info.child).box;
+	QRectF parentRect = parentBox->sceneBoundingRect();
+	QRectF childRect = childBox->sceneBoundingRect();
+	QPointF from(parentRect.center().x(), parentRect.bottom());
+	QPointF to(childRect.center().x(), childRect.top());
+
+	QPainterPath path(from);
+	QPointF control(0, (to.y() - from.y()) / 2.0);
+	path.cubicTo(from + control, to - control, to);
+	if (items.line->path() != path) {
+		items.line->setPath(path);
+		QPolygonF arrow;
+		arrow << to << to + QPointF(-ARROW_SIZE / 2.0, -ARROW_SIZE)
+				<< to + QPointF(ARROW_SIZE / 2.0, -ARROW_SIZE);
+		items.arrow->setPolygon(arrow);
+	}
+
+	QColor color(Qt::black);
+	if (items.stale) {
+		color = Qt::red;
+	} else if (items.info.isStatic) {
+		color = Qt::darkGray;
+	}
+	QPen pen(color);
+	if (items.info.isStatic) {
+		pen.setStyle(Qt::DashLine);
+	}
+	if (items.line->pen() != pen) {
+		items.line->setPen(pen);
+		items.arrow->setBrush(QBrush(color));
+		childBox->setPen(QPen(items.stale ? Qt::red : Qt::black));
+	}
+
+	QString text = edgeLabel(items.info);
+	if (items.label->text() != text) {
+		items.label->setText(text);
+	}
+	QPointF middle = path.pointAtPercent(0.5);
+	QPointF labelPos(middle.x() + 4.0, middle.y() - items.label->boundingRect().height() / 2.0);
+	if (items.label->pos() != labelPos) {
+		items.label->setPos(labelPos);
+	}
+}
+
+void GraphViewer::relayout() {
+	TreeLayout layout(HORIZONTAL_GAP, LAYER_HEIGHT);
+	for (NodeMap::iterator it = nodes.begin(); it != nodes.end(); ++it) {
+		layout.setNodeWidth(it->first, it->second.box->rect().width());
+	}
+	for (EdgeMap::iterator it = edges.begin(); it != edges.end(); ++it) {
+		layout.addEdge(it->first.first, it->first.second);
+	}
+
+	map<string, TreeLayout::Node> positions = layout.compute();
+	map<string, TreeLayout::Node>::iterator pIt;
+	for (pIt = positions.begin(); pIt != positions.end(); ++pIt) {
+		QGraphicsRectItem *box = node(pIt->first).box;
+		QPointF pos(pIt->second.x - pIt->second.width / 2.0, pIt->second.y);
+		if (box->pos() != pos) {
+			box->setPos(pos);
+		}
+	}
+	for (EdgeMap::iterator it = edges.begin(); it != edges.end(); ++it) {
+		updateEdge(it->second);
+	}
+	scene->setSceneRect(scene->itemsBoundingRect().adjusted(-20, -20, 20, 20));
+}
+
+void GraphViewer::updateGraph(const vector<EdgeInfo> &infos) {
+	size_t knownNodes = nodes.size();
+	size_t knownEdges = edges.size();
+	boost::uint64_t now = monotonicNanos();
+
+	vector<EdgeItems*> changed;
+	for (vector<EdgeInfo>::const_iterator it = infos.begin(); it != infos.end(); ++it) {
+		node(it->parent);
+		node(it->child);
+		EdgeItems &items = edge(*it);
+		items.info = *it;
+		items.stale = staleFactor > 0.0 && EdgeMonitor::isStale(*it, now, staleFactor);
+		changed.push_back(&items);
+	}
+
+	if (nodes.size() != knownNodes || edges.size() != knownEdges) {
+		relayout();
+	} else {
+		for (vector<EdgeItems*>::iterator it = changed.begin(); it != changed.end(); ++it) {
+			updateEdge(**it);
+		}
+	}
+
+	if (!fitted && !nodes.empty()) {
+		fitted = true;
+		fitToWindow();
+	}
+}
+
+void GraphViewer::follow(EdgeMonitor::Ptr monitor, int intervalMillis) {
+	this->monitor = monitor;
+	if (!timer) {
+		timer = new QTimer(this);
+		connect(timer, SIGNAL(timeout()), this, SLOT(refresh()));
+	}
+	timer->start(intervalMillis);
+	refresh();
+}
+
+void GraphViewer::setStaleFactor(double staleFactor) {
+	this->staleFactor = staleFactor;
+}
+
+void GraphViewer::refresh() {
+	if (monitor) {
+		updateGraph(monitor->snapshot());
+	}
+}
+
+bool GraphViewer::eventFilter(QObject *object, QEvent *event) {
+	if (object == view->viewport() && event->type() == QEvent::Wheel) {
+		QWheelEvent *wheel = static_cast<QWheelEvent*>(event);
+		scaleView(wheel->angleDelta().y() > 0 ? 1.125 : 0.9);
+		return true;
+	}
+	return QMainWindow::eventFilter(object, event);
+}
+
+void GraphViewer::zoomIn() {
+	scaleView(1.25);
+}
+
+void GraphViewer::zoomOut() {
+	scaleView(0.8);
+}
+
+void GraphViewer::normalSize() {
+	view->resetTransform();
+	scaleFactor = 1.0;
+}
+
+void GraphViewer::fitToWindow() {
+	view->fitInView(scene->sceneRect(), Qt::KeepAspectRatio);
+	scaleFactor = view->transform().m11();
+}
+
+void GraphViewer::scaleView(double factor) {
+	double scale = scaleFactor * factor;
+	if (scale < 0.05 || scale > 20.0) {
+		return;
+	}
+	scaleFactor = scale;
+	view->scale(factor, factor);
+}
+
+void GraphViewer::about() {
+	QMessageBox::about(this, tr("About rct-view"),
+			tr("<p><b>rct-view</b> shows the tree of coordinate frames known to "
+					"rct. Every edge is labelled with the authority publishing it "
+					"and its update rate.</p>"));
+}
+
+void GraphViewer::createActions() {
+	exitAct = new QAction(tr("E&xit"), this);
+	exitAct->setShortcut(tr("Ctrl+Q"));
+	connect(exitAct, SIGNAL(triggered()), this, SLOT(close()));
+
+	zoomInAct = new QAction(tr("Zoom &In (25%)"), this);
+	zoomInAct->setShortcut(tr("Ctrl++"));
+	connect(zoomInAct, SIGNAL(triggered()), this, SLOT(zoomIn()));
+
+	zoomOutAct = new QAction(tr("Zoom &Out (25%)"), this);
+	zoomOutAct->setShortcut(tr("Ctrl+-"));
+	connect(zoomOutAct, SIGNAL(triggered()), this, SLOT(zoomOut()));
+
+	normalSizeAct = new QAction(tr("&Normal Size"), this);
+	normalSizeAct->setShortcut(tr("Ctrl+S"));
+	connect(normalSizeAct, SIGNAL(triggered()), this, SLOT(normalSize()));
+
+	fitToWindowAct = new QAction(tr("&Fit to Window"), this);
+	fitToWindowAct->setShortcut(tr("Ctrl+F"));
+	connect(fitToWindowAct, SIGNAL(triggered()), this, SLOT(fitToWindow()));
+
+	aboutAct = new QAction(tr("&About"), this);
+	connect(aboutAct, SIGNAL(triggered()), this, SLOT(about()));
+
+	aboutQtAct = new QAction(tr("About &Qt"), this);
+	connect(aboutQtAct, SIGNAL(triggered()), qApp, SLOT(aboutQt()));
+}
+
+void GraphViewer::createMenus() {
+	fileMenu = new QMenu(tr("&File"), this);
+	fileMenu->addAction(exitAct);
+
+	viewMenu = new QMenu(tr("&View"), this);
+	viewMenu->addAction(zoomInAct);
+	viewMenu->addAction(zoomOutAct);
+	viewMenu->addAction(normalSizeAct);
+	viewMenu->addSeparator();
+	viewMenu->addAction(fitToWindowAct);
+
+	helpMenu = new QMenu(tr("&Help"), this);
+	helpMenu->addAction(aboutAct);
+	helpMenu->addAction(aboutQtAct);
+
+	menuBar()->addMenu(fileMenu);
+	menuBar()->addMenu(viewMenu);
+	menuBar()->addMenu(helpMenu);
+}
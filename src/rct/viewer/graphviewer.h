@@ -0,0 +1,120 @@
+#pragma once
+
+#include <QMainWindow>
+#include <QPointF>
+
+#include "../monitor/EdgeMonitor.h"
+
+#include <map>
+#include <string>
+#include <vector>
+
+class QAction;
+class QEvent;
+class QGraphicsPathItem;
+class QGraphicsPolygonItem;
+class QGraphicsRectItem;
+class QGraphicsScene;
+class QGraphicsSimpleTextItem;
+class QGraphicsView;
+class QMenu;
+class QTimer;
+
+/**
+ * Shows the frame tree as vector items laid out by rct::TreeLayout.
+ */
+class GraphViewer: public QMainWindow {
+	Q_OBJECT
+
+public:
+	GraphViewer();
+	virtual ~GraphViewer();
+
+	/**
+	 * Adds new frames and edges, updates the edge labels and moves the frames
+	 * to their new layout positions. Existing items are kept and only changed
+	 * where necessary.
+	 */
+	void updateGraph(const std::vector<rct::EdgeInfo> &edges);
+
+	/**
+	 * Polls the monitor every intervalMillis and applies the changes with
+	 * updateGraph(). Only new frames cause a new layout.
+	 */
+	void follow(rct::EdgeMonitor::Ptr monitor, int intervalMillis);
+
+	/**
+	 * Dynamic edges not updated for staleFactor times their mean interval are
+	 * highlighted. Zero disables the highlighting.
+	 */
+	void setStaleFactor(double staleFactor);
+
+protected:
+	bool eventFilter(QObject *object, QEvent *event);
+
+private slots:
+	void zoomIn();
+	void zoomOut();
+	void normalSize();
+	void fitToWindow();
+	void about();
+	void refresh();
+
+private:
+	class NodeItems {
+	public:
+		NodeItems() :
+				box(0), label(0) {
+		}
+		QGraphicsRectItem *box;
+		QGraphicsSimpleTextItem *label;
+	};
+
+	class EdgeItems {
+	public:
+		EdgeItems() :
+				stale(false), line(0), arrow(0), label(0) {
+		}
+		rct::EdgeInfo info;
+		bool stale;
+		QGraphicsPathItem *line;
+		QGraphicsPolygonItem *arrow;
+		QGraphicsSimpleTextItem *label;
+	};
+
+	typedef std::map<std::string, NodeItems> NodeMap;
+	typedef std::map<std::pair<std::string, std::string>, EdgeItems> EdgeMap;
+
+	void createActions();
+	void createMenus();
+	void scaleView(double factor);
+	NodeItems &node(const std::string &name);
+	EdgeItems &edge(const rct::EdgeInfo &info);
+	void relayout();
+	void updateEdge(EdgeItems &items);
+	QString edgeLabel(const rct::EdgeInfo &info) const;
+
+	QGraphicsScene *scene;
+	QGraphicsView *view;
+	double scaleFactor;
+	bool fitted;
+	double staleFactor;
+
+	rct::EdgeMonitor::Ptr monitor;
+	QTimer *timer;
+
+	NodeMap nodes;
+	EdgeMap edges;
+
+	QAction *exitAct;
+	QAction *zoomInAct;
+	QAction *zoomOutAct;
+	QAction *normalSizeAct;
+	QAction *fitToWindowAct;
+	QAction *aboutAct;
+	QAction *aboutQtAct;
+
+	QMenu *fileMenu;
+	QMenu *viewMenu;
+	QMenu *helpMenu;
+};
@@ -3,11 +3,13 @@
 #include <QMenuBar>
 #include <QScrollBar>
 #include <QWheelEvent>
-#include <QLabel>
+#include <QPainter>
+#include <QPaintEvent>
 #include <QAction>
 #include <QMenu>
 #include <QScrollArea>
 
+#include <cmath>
 #include <iostream>
 
 #include "imageviewer.h"
@@ -26,15 +28,118 @@ public:
 };
 DisableWheelFilter* filter = new DisableWheelFilter();
 
+namespace {
+
+// tile edge length in pixels
+const int TILE_SIZE = 256;
+// resolution at scale 1.0
+const double BASE_DPI = 96.0;
+const int DEFAULT_CACHE_MB = 64;
+
+}
+
+ImageTileRenderer::ImageTileRenderer(const QImage &image) :
+		image(image) {
+}
+
+QSizeF ImageTileRenderer::pageSize() const {
+	return QSizeF(image.size());
+}
+
+QImage ImageTileRenderer::render(double dpi, const QRect &rect) const {
+	double scale = dpi / 72.0;
+	QRectF source(rect.x() / scale, rect.y() / scale, rect.width() / scale,
+			rect.height() / scale);
+	return image.copy(source.toAlignedRect()).scaled(rect.size(), Qt::IgnoreAspectRatio,
+			Qt::SmoothTransformation);
+}
+
+TileView::TileView(QWidget *parent) :
+		QWidget(parent), renderer(0) {
+	setBackgroundRole(QPalette::Base);
+	setAutoFillBackground(true);
+	setCacheSize(DEFAULT_CACHE_MB);
+}
+
+TileView::~TileView() {
+	delete renderer;
+}
+
+void TileView::setRenderer(TileRenderer *renderer) {
+	tiles.clear();
+	delete this->renderer;
+	this->renderer = renderer;
+	update();
+}
+
+bool TileView::hasRenderer() const {
+	return renderer != 0;
+}
+
+void TileView::setCacheSize(int megabytes) {
+	// cost of a tile is its size in kilobytes
+	tiles.setMaxCost(megabytes * 1024);
+}
+
+QSize TileView::sizeForScale(double scale) const {
+	if (!renderer) {
+		return QSize();
+	}
+	QSizeF page = renderer->pageSize() * (scale * BASE_DPI / 72.0);
+	return QSize(int(ceil(page.width())), int(ceil(page.height())));
+}
+
+double TileView::currentDpi() const {
+	QSizeF page = renderer->pageSize();
+	if (page.isEmpty()) {
+		return BASE_DPI;
+	}
+	return 72.0 * qMin(width() / page.width(), height() / page.height());
+}
+
+void TileView::paintEvent(QPaintEvent *event) {
+	if (!renderer) {
+		return;
+	}
+	double dpi = currentDpi();
+	QSizeF pageSize = renderer->pageSize() * (dpi / 72.0);
+	QRect page(0, 0, int(ceil(pageSize.width())), int(ceil(pageSize.height())));
+	QRect visible = event->rect().intersected(page);
+	if (visible.isEmpty()) {
+		return;
+	}
+
+	QPainter painter(this);
+	int dpiKey = qRound(dpi * 16.0);
+	for (int row = visible.top() / TILE_SIZE; row <= visible.bottom() / TILE_SIZE; ++row) {
+		for (int col = visible.left() / TILE_SIZE; col <= visible.right() / TILE_SIZE; ++col) {
+			QRect tileRect = QRect(col * TILE_SIZE, row * TILE_SIZE, TILE_SIZE, TILE_SIZE)
+					.intersected(page);
+			QString key = QString("%1:%2:%3").arg(dpiKey).arg(col).arg(row);
+			QImage *tile = tiles.object(key);
+			if (tile) {
+				painter.drawImage(tileRect.topLeft(), *tile);
+				continue;
+			}
+			QImage rendered = renderer->render(dpi, tileRect);
+			painter.drawImage(tileRect.topLeft(), rendered);
+#if QT_VERSION >= QT_VERSION_CHECK(5, 10, 0)
+			int cost = qMax(1, int(rendered.sizeInBytes() / 1024));
+#else
+			int cost = qMax(1, rendered.byteCount() / 1024);
+#endif
+			tiles.insert(key, new QImage(rendered), cost);
+		}
+	}
+}
+
 ImageViewer::ImageViewer() {
-	imageLabel = new QLabel(this);
-	imageLabel->setBackgroundRole(QPalette::Base);
-	imageLabel->setSizePolicy(QSizePolicy::Ignored, QSizePolicy::Ignored);
-	imageLabel->setScaledContents(true);
+	tileView = new TileView(this);
+	tileView->setSizePolicy(QSizePolicy::Ignored, QSizePolicy::Ignored);
 
 	scrollArea = new QScrollArea(this);
 	scrollArea->setBackgroundRole(QPalette::Dark);
-	scrollArea->setWidget(imageLabel);
+	scrollArea->setWidget(tileView);
 	scrollArea->viewport()->installEventFilter(filter);
 	setCentralWidget(scrollArea);
 
@@ -67,13 +172,21 @@ bool ImageViewer::showImage(const QImage &image) {
 	if (image.isNull()) {
 		return false;
 	}
-	imageLabel->setPixmap(QPixmap::fromImage(image));
+	return showPage(new ImageTileRenderer(image));
+}
+
+bool ImageViewer::showPage(TileRenderer *renderer) {
+	if (!renderer || renderer->pageSize().isEmpty()) {
+		delete renderer;
+		return false;
+	}
+	tileView->setRenderer(renderer);
 
 	fitToWindowAct->setEnabled(true);
 	updateActions();
 
 	if (!fitToWindowAct->isChecked())
-		imageLabel->adjustSize();
+		tileView->resize(tileView->sizeForScale(1.0));
 
 	fitToWindow();
 	scaleImageTo(scaleFactor);
@@ -89,7 +202,7 @@ void ImageViewer::zoomOut() {
 }
 
 void ImageViewer::normalSize() {
-	imageLabel->adjustSize();
+	tileView->resize(tileView->sizeForScale(1.0));
 	scaleFactor = 1.0;
 }
 
@@ -104,18 +217,9 @@ void ImageViewer::fitToWindow() {
 
 void ImageViewer::about() {
 	QMessageBox::about(this, tr("About Image Viewer"),
-			tr("<p>The <b>Image Viewer</b> example shows how to combine QLabel "
-					"and QScrollArea to display an image. QLabel is typically used "
-					"for displaying a text, but it can also display an image. "
-					"QScrollArea provides a scrolling view around another widget. "
-					"If the child widget exceeds the size of the frame, QScrollArea "
-					"automatically provides scroll bars. </p><p>The example "
-					"demonstrates how QLabel's ability to scale its contents "
-					"(QLabel::scaledContents), and QScrollArea's ability to "
-					"automatically resize its contents "
-					"(QScrollArea::widgetResizable), can be used to implement "
-					"zooming and scaling features. </p><p>In addition the example "
-					"shows how to use QPainter to print an image.</p>"));
+			tr("<p>The <b>Image Viewer</b> shows the graph rendered by graphviz. "
+					"Only the visible tiles are rendered, at the resolution of the "
+					"current zoom level, and recently shown tiles are cached.</p>"));
 }
 
 void ImageViewer::createActions() {
@@ -185,14 +289,14 @@ void ImageViewer::scaleImage(double factor) {
 }
 
 void ImageViewer::scaleImageTo(double scale) {
-	Q_ASSERT(imageLabel->pixmap());
-	imageLabel->resize(scale * imageLabel->pixmap()->size());
+	Q_ASSERT(tileView->hasRenderer());
+	tileView->resize(tileView->sizeForScale(scale));
 
 	adjustScrollBar(scrollArea->horizontalScrollBar(), scale);
 	adjustScrollBar(scrollArea->verticalScrollBar(), scale);
 
-	zoomInAct->setEnabled(scale < 3.0);
-	zoomOutAct->setEnabled(scale > 0.333);
+	zoomInAct->setEnabled(scale < 12.0);
+	zoomOutAct->setEnabled(scale > 0.1);
 }
 
 void ImageViewer::adjustScrollBar(QScrollBar *scrollBar, double factor) {
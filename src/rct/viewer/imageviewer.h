@@ -1,13 +1,69 @@
 #pragma once
 
 #include <QMainWindow>
+#include <QCache>
+#include <QImage>
+#include <QWidget>
 
 class QAction;
-class QLabel;
 class QMenu;
+class QPaintEvent;
 class QScrollArea;
 class QScrollBar;
 
+/**
+ * Source of the pixels shown by ImageViewer. Only the requested part of the
+ * page is rendered, at the requested resolution.
+ */
+class TileRenderer {
+public:
+	virtual ~TileRenderer() {
+	}
+	/** size of the page in points (1/72 inch) */
+	virtual QSizeF pageSize() const = 0;
+	/** renders rect, given in pixels of the page at dpi */
+	virtual QImage render(double dpi, const QRect &rect) const = 0;
+};
+
+/**
+ * Serves tiles from an image in memory, one image pixel per point.
+ */
+class ImageTileRenderer: public TileRenderer {
+public:
+	ImageTileRenderer(const QImage &image);
+	QSizeF pageSize() const;
+	QImage render(double dpi, const QRect &rect) const;
+
+private:
+	QImage image;
+};
+
+/**
+ * Draws the visible tiles of a page at the resolution matching the widget
+ * size. Rendered tiles are kept in a cache bounded by memory, so memory use
+ * does not grow with the page or the zoom level.
+ */
+class TileView: public QWidget {
+public:
+	TileView(QWidget *parent = 0);
+	virtual ~TileView();
+
+	/** takes ownership of renderer */
+	void setRenderer(TileRenderer *renderer);
+	bool hasRenderer() const;
+	void setCacheSize(int megabytes);
+	QSize sizeForScale(double scale) const;
+
+protected:
+	void paintEvent(QPaintEvent *event);
+
+private:
+	double currentDpi() const;
+
+	TileRenderer *renderer;
+	QCache<QString, QImage> tiles;
+};
+
 class ImageViewer: public QMainWindow {
 	Q_OBJECT
 
@@ -16,6 +72,8 @@ public:
 	virtual ~ImageViewer();
 	void open(const QString &file);
 	bool showImage(const QImage &image);
+	/** takes ownership of renderer */
+	bool showPage(TileRenderer *renderer);
 
 private slots:
 	void zoomIn();
@@ -33,7 +91,7 @@ private:
 	void adjustScrollBar(QScrollBar *scrollBar, double factor);
 	void wheelEvent(QWheelEvent * event);
 
-	QLabel *imageLabel;
+	TileView *tileView;
 	QScrollArea *scrollArea;
 	double scaleFactor;
 